@@ -0,0 +1,223 @@
+/*
+ *
+ * binload.c -- binary framed upload for the bootloader
+ *
+ * (c)2022, J.E.J. op den Brouw <J.E.J.opdenBrouw@hhs.nl
+ *
+ */
+
+/* The binary upload is entered after the host sends a 'B'
+ * in upload mode. Each frame holds a block of raw data and
+ * a CRC32, so the host doesn't have to hex encode the data.
+ * Each frame is acknowledged with 'A' or 'N' followed by the
+ * sequence number of the frame. On a NAK, the host resends
+ * the frame. A 'C' frame holds compressed data, which is
+ * decompressed straight into memory. An 'E' frame sets the
+ * start address, a 'Z' frame ends binary mode.
+ *
+ * The host may have up to BIN_WINDOW frames in flight, so the
+ * turnaround time is paid once per window instead of once per
+ * frame. The receive interrupt keeps receiving while a response
+ * is sent. Every frame carries its own address, so frames may
+ * be resent in any order.
+ *
+ * The same frames are used to read back memory. binsend
+ * sends a memory range in 'D' frames followed by a 'Z' frame,
+ * without waiting for responses. The host asks again for the
+ * frames it did not receive correctly. */
+
+#include "io.h"
+#include "usart.h"
+#include "crc.h"
+#include "util.h"
+#include "binload.h"
+
+/* Frame buffer, header + payload + crc */
+static unsigned char frame[BIN_HDRLEN+BIN_MAXLEN+4];
+
+/* Fetch Little Endian 16 and 32 bit values from the frame */
+static unsigned long get16(unsigned char *p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+static unsigned long get32(unsigned char *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned long) p[3] << 24);
+}
+
+/* Write len bytes to memory at addr, decompress if packed.
+ * The compressed data is a series of tokens. A token below
+ * 0x80 is followed by token+1 literal bytes. A token of 0x80
+ * or higher copies (token & 0x7f)+3 bytes from earlier output,
+ * the distance back follows as a Little Endian 16-bit value.
+ * Copies may overlap, a distance of 1 repeats the last byte.
+ * Raw data is written as literal runs of 128 bytes */
+static void memwrite(unsigned long addr, unsigned char *p, unsigned long len, int packed)
+{
+	unsigned char *end = p + len;
+	unsigned long n, off;
+
+	wr_start(addr);
+	while (p < end) {
+		n = packed ? *p++ : 0x7f;
+		if (n < 0x80) {
+			/* Literal run */
+			for (n++; n > 0 && p < end; n--) {
+				wr_put(*p++);
+			}
+		} else {
+			/* Copy from earlier output */
+			off = get16(p);
+			p += 2;
+			for (n = (n & 0x7f) + 3; n > 0; n--) {
+				wr_put(wr_get(off));
+			}
+		}
+	}
+	wr_flush();
+}
+
+/* Send a response and the sequence number of the frame */
+static void putresp(int c)
+{
+	usart_putc(c);
+	usart_putc(frame[1]);
+}
+
+/* Receive one frame, returns the payload length, BIN_ERR_CRC
+ * if the frame is received but the CRC is wrong, or BIN_ERR_SYNC
+ * on timeout, bad length or bad type. The receive interrupt
+ * buffers the next frame while the CRC is checked */
+static long getframe(void)
+{
+	unsigned long i, n, len = 0;
+	int c;
+
+	/* Wait for the first byte without timeout */
+	frame[0] = usart_getc();
+
+	/* Read in header, payload and CRC. The length is
+	 * known after the header */
+	n = BIN_HDRLEN;
+	for (i = 1; i < n + 4; i++) {
+		if ((c = usart_getc_timeout(BIN_TIMEOUT)) < 0) {
+			return BIN_ERR_SYNC;
+		}
+		frame[i] = c;
+		if (i == BIN_HDRLEN - 1) {
+			len = get16(frame+2);
+			if (len > BIN_MAXLEN) {
+				return BIN_ERR_SYNC;
+			}
+			if (frame[0] != BIN_DATA && frame[0] != BIN_PACKED &&
+			    frame[0] != BIN_ENTRY && frame[0] != BIN_END) {
+				return BIN_ERR_SYNC;
+			}
+			n += len;
+		}
+	}
+
+	/* Bytes were lost, the frame is out of sync */
+	if (usart_overruns() > 0) {
+		return BIN_ERR_SYNC;
+	}
+
+	if (crc32(0, frame, n) != get32(frame + n)) {
+		return BIN_ERR_CRC;
+	}
+
+	return len;
+}
+
+/* Run the binary upload, returns the (updated) start address */
+unsigned long binload(unsigned long entry)
+{
+	long len;
+
+	while (1) {
+		GPIOA->POUT ^= 0x01;
+		len = getframe();
+		if (len == BIN_ERR_SYNC) {
+			/* Lost track of the frames, eat up everything
+			 * until the line is idle, then signal failure */
+			while (usart_getc_timeout(BIN_TIMEOUT) >= 0);
+		}
+		if (len < 0) {
+			putresp(BIN_NAK);
+			continue;
+		}
+		switch (frame[0]) {
+			case BIN_DATA:
+			case BIN_PACKED:
+				memwrite(get32(frame+4), frame+BIN_HDRLEN, len, frame[0] == BIN_PACKED);
+				break;
+			case BIN_ENTRY:
+				entry = get32(frame+4);
+				break;
+			default:
+				break;
+		}
+		putresp(BIN_ACK);
+		if (frame[0] == BIN_END) {
+			return entry;
+		}
+	}
+}
+
+/* Send one byte, the byte is written as soon as the
+ * transmitter is idle, so that the next byte can be
+ * prepared while this one is sent */
+static void putbyte(int c)
+{
+	while ((USART->STAT & 0x10) == 0);
+	USART->DATA = c;
+}
+
+/* Send one frame of len bytes at p */
+static void putframe(int type, int seq, unsigned long addr, unsigned char *p, unsigned long len)
+{
+	unsigned long i, crc;
+
+	frame[0] = type;
+	frame[1] = seq;
+	frame[2] = len;
+	frame[3] = len >> 8;
+	frame[4] = addr;
+	frame[5] = addr >> 8;
+	frame[6] = addr >> 16;
+	frame[7] = addr >> 24;
+
+	crc = crc32(0, frame, BIN_HDRLEN);
+	for (i = 0; i < BIN_HDRLEN; i++) {
+		putbyte(frame[i]);
+	}
+	/* The CRC is calculated while the byte is sent */
+	for (i = 0; i < len; i++) {
+		putbyte(p[i]);
+		crc = crc32(crc, p+i, 1);
+	}
+	for (i = 0; i < 4; i++) {
+		putbyte(crc >> (8*i));
+	}
+}
+
+/* Send len bytes of memory at addr in frames, followed
+ * by an end frame */
+void binsend(unsigned long addr, unsigned long len)
+{
+	unsigned long n;
+	int seq = 0;
+
+	while (len > 0) {
+		GPIOA->POUT ^= 0x01;
+		n = len < BIN_MAXLEN ? len : BIN_MAXLEN;
+		putframe(BIN_DATA, seq++, addr, (unsigned char *) addr, n);
+		addr += n;
+		len -= n;
+	}
+	putframe(BIN_END, seq, addr, frame, 0);
+
+	/* Wait for the last byte to be sent */
+	while ((USART->STAT & 0x10) == 0);
+}
@@ -0,0 +1,37 @@
+#ifndef _BINLOAD_H_
+#define _BINLOAD_H_
+
+/* Frame layout (all fields Little Endian):
+ *   type (1) | seq (1) | len (2) | addr (4) | payload (len) | crc32 (4)
+ * The CRC32 is calculated over type up to and including the payload */
+#define BIN_HDRLEN (8)
+/* Maximum payload per frame */
+#define BIN_MAXLEN (256)
+/* Inter-byte timeout in micro seconds */
+#define BIN_TIMEOUT (100000UL)
+/* Number of frames the host may send without waiting for
+ * a response, reported to the host after the 'B'. One frame
+ * is in the frame buffer, the others must fit in the receive
+ * ring buffer of the USART (USART_RXLEN in usart.h) */
+#define BIN_WINDOW (1 + (USART_RXLEN-1) / (BIN_HDRLEN+BIN_MAXLEN+4))
+
+/* Errors on receiving a frame */
+#define BIN_ERR_CRC (-1)
+#define BIN_ERR_SYNC (-2)
+
+/* Frame types */
+#define BIN_DATA 'D'
+#define BIN_PACKED 'C'
+#define BIN_ENTRY 'E'
+#define BIN_END 'Z'
+
+/* Frame responses, followed by the sequence number */
+#define BIN_ACK 'A'
+#define BIN_NAK 'N'
+
+/* Run the binary upload, returns the (updated) start address */
+unsigned long binload(unsigned long entry);
+/* Send len bytes of memory at addr in frames */
+void binsend(unsigned long addr, unsigned long len);
+
+#endif
@@ -15,15 +15,57 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
-#include <ctype.h>
 
 #include "io.h"
 #include "usart.h"
 #include "util.h"
+#include "binload.h"
+#include "hwload.h"
+#include "crc.h"
 
-#define VERSION "v0.1"
+#define VERSION "v0.2"
 #define BUFLEN (41)
-#define BOOTWAIT (10)
+/* Time to wait for a key hit in milliseconds, may be set
+ * from the Makefile. The wait is shown in BOOTSTEPS steps */
+#ifndef BOOTWAIT
+#define BOOTWAIT (5000)
+#endif
+#define BOOTSTEPS (10)
+/* Optional commands, may be set from the Makefile. All are
+ * included by default and fit in the 8 KB boot ROM. Without
+ * them, the bootloader holds the S-records, the binary
+ * transfer with compression and the basic monitor.
+ * WITH_BAUD:    R, baud rate negotiation
+ * WITH_CRC:     H, block CRCs for delta upload and verify
+ * WITH_READ:    G, read back memory
+ * WITH_HWLOAD:  L, hardware loader
+ * WITH_MEMCMDS: monitor commands fw, cw, cm and crc */
+#ifndef WITH_BAUD
+#define WITH_BAUD (1)
+#endif
+#ifndef WITH_CRC
+#define WITH_CRC (1)
+#endif
+#ifndef WITH_READ
+#define WITH_READ (1)
+#endif
+#ifndef WITH_HWLOAD
+#define WITH_HWLOAD (1)
+#endif
+#ifndef WITH_MEMCMDS
+#define WITH_MEMCMDS (1)
+#endif
+/* Start the application at once if this input is high,
+ * SW9 on the DE0-CV board */
+#define BOOTSTRAP (1 << 9)
+/* Start the application at once if BOOTMAGIC is found at
+ * BOOTMAGIC_ADDR. The application writes it and jumps to the
+ * bootloader for a warm restart. The word is below the stack
+ * and above the data of the bootloader, so it survives the
+ * startup of the bootloader */
+#define BOOTMAGIC_ADDR (0x20007c00UL)
+#define BOOTMAGIC (0x424f4f54UL)
+#define BOOTMAGIC_WORD (*(volatile unsigned long *) BOOTMAGIC_ADDR)
 
 int main(void) {
 
@@ -33,6 +75,7 @@ int main(void) {
 	char buffer[BUFLEN];
 	/* Used in initial delay */
 	int count;
+	unsigned long start;
 	/* Used to test on key hit */
 	int keyhit = 0;
 	/* */
@@ -41,19 +84,30 @@ int main(void) {
 	unsigned long addr = 0;
 
 
-	/* Initialize USART at 9600 bps */
+	/* Start the application without waiting if the strap is
+	 * set or on a warm restart. The magic is cleared, so the
+	 * next reset waits again */
+	if ((GPIOA->PIN & BOOTSTRAP) || BOOTMAGIC_WORD == BOOTMAGIC) {
+		BOOTMAGIC_WORD = 0;
+		(*app_start)();
+	}
+
+	/* Initialize USART at 9600 bps, receive with interrupts */
 	usart_init();
 
 	/* Send greeting */
 	usart_puts("\r\nTHUAS RISC-V Bootloader " VERSION "\r\n");
 
-	/* Wait a short while for a key hit */
-	GPIOA->POUT = (1<<BOOTWAIT)-1;
-	for (count = 1; count <= BOOTWAIT*1024*1024; count++) {
-		/* Modulo power of 2 save a rem instruction */
-		if (count % (1024*1024) == 0) {
+	/* Wait a short while for a key hit, timed with TIME
+	 * (micro seconds), independent of the clock frequency */
+	GPIOA->POUT = (1<<BOOTSTEPS)-1;
+	start = TIME;
+	count = 0;
+	while (count < BOOTSTEPS) {
+		if (TIME - start >= (count+1) * (BOOTWAIT*1000UL/BOOTSTEPS)) {
 			usart_putc('*');
 			GPIOA->POUT >>= 1;
+			count++;
 		}
 		if (usart_received()) {
 			keyhit = 1;
@@ -65,7 +119,7 @@ int main(void) {
 	/* If no key was hit with the time frame,
 	 * start the application */
 	if (!keyhit) {
-		USART->BAUD = 0;
+		usart_stop();
 		(*app_start)();
 	}
 
@@ -83,80 +137,108 @@ int main(void) {
 				c = usart_getc();
 				/* Type 1, 2, 3 is data record */
 				if (c == '1' || c == '2' || c == '3') {
-					/* Get count, read start address and ignore check byte */
-					unsigned long count;
-					unsigned long v;
-					if (c == '1') {
-						count = gethex(2) - 3;
-						v = gethex(4);
-					} else if (c == '2') {
-						count = gethex(2) - 4;
-						v = gethex(6);
-					} else {
-						count = gethex(2) - 5;
-						v = gethex(8);
-					}
-					/* Process bytes */
+					/* Get count, read start address and ignore check byte.
+					 * The address has 2, 3 or 4 bytes */
+					unsigned long alen = c - '0' + 1;
+					unsigned long count = gethex(2) - alen - 1;
+					unsigned long v = gethex(alen * 2);
+					/* Collect the bytes in words, each ROM
+					 * word is written once */
+					wr_start(v);
 					for (unsigned long i = 0; i < count; i++) {
-						/* Set address, get byte and word data */
-						unsigned long *boun = (unsigned long *) (v & ~3);
-						unsigned long byte = gethex(2);
-						unsigned long word = *boun;
-
-						/* Patch the byte in the word */
-						switch (v & 3) {
-							case 0: word = (word & ~0xffUL) | byte;
-								break;
-							case 1: word = (word & ~0xff00UL) | (byte << 8);
-								break;
-							case 2: word = (word & ~0xff0000UL) | (byte << 16);
-								break;
-							case 3: word = (word & ~0xff000000UL) | (byte << 24);
-								break;
-							default:
-								break;
-						}
-						/* Write back the word */
-						*boun = word;
-						v++;
+						wr_put(gethex(2));
 					}
-					/* Read in rest of line */
-					while ((c = usart_getc()) != '\n');
+					wr_flush();
 				} else
 				/* Type 7, 8, 9 is end record with start address */
 				if (c == '7' || c == '8' || c == '9') {
 					/* Skip count */
 					unsigned long v = gethex(2);
-					/* Read in start address */
-					if (c == '7') {
-						v = gethex(8);
-					} else if (c == '8') {
-						v = gethex(6);
-					} else {
-						v = gethex(4);
-					}
-					/* Read in rest of line */
-					while ((c = usart_getc()) != '\n');
+					/* Read in start address of 4, 3 or 2 bytes */
+					v = gethex(('9' - c + 2) * 2);
 					/* Set start address */
 					app_start = (void *) v;
-				} else {
-					/* Skip other records, eat up line */
-					while ((c = usart_getc()) != '\n');
 				}
+				/* Read in rest of line, other records are skipped */
+				while ((c = usart_getc()) != '\n');
+			} else if (c == 'B') {
+				/* Binary upload, acknowledge with the window size
+				 * and process frames until the end frame is received */
+				usart_putc('B');
+				printhex(BIN_WINDOW, 2);
+				usart_puts("\n");
+				app_start = (void *) binload((unsigned long) app_start);
+				continue;
+#if WITH_HWLOAD
+			} else if (c == 'L') {
+				/* Hardware loader, the loader in the FPGA writes
+				 * the S-records to the ROM and reports when done */
+				app_start = (void *) hwload((unsigned long) app_start);
+				continue;
+#endif
+#if WITH_BAUD
+			} else if (c == 'R') {
+				/* Baud rate negotiation, acknowledge and read
+				 * in the proposed rate */
+				usart_puts("R\n");
+				usart_negotiate();
+				continue;
+#endif
+#if WITH_CRC
+			} else if (c == 'H') {
+				/* Block CRCs, acknowledge and read in start address,
+				 * length and block size, then send the CRC32 of
+				 * every block */
+				unsigned long v, len, size, n;
+				usart_puts("H\n");
+				v = gethex(8);
+				len = gethex(8);
+				size = gethex(8);
+				while (len > 0 && size > 0) {
+					n = len < size ? len : size;
+					printhex(crc32(0, (unsigned char *) v, n), 8);
+					v += n;
+					len -= n;
+				}
+				usart_puts("\n");
+				continue;
+#endif
+#if WITH_READ
+			} else if (c == 'G') {
+				/* Read back memory, acknowledge and read in start
+				 * address and length, then send the memory in
+				 * binary frames */
+				unsigned long v, len;
+				usart_puts("G\n");
+				v = gethex(8);
+				len = gethex(8);
+				binsend(v, len);
+				continue;
+#endif
 			} else if (c == 'J') {
 				/* Start application after upload */
-				USART->BAUD = 0;
+				usart_stop();
 				GPIOA->POUT = 0;
 				(*app_start)();
 				break;
 				/* Break to bootloader */
 			} else if (c == '#') {
+				/* Acknowledge at the current rate, the
+				 * monitor runs at the default rate */
+				usart_puts("\r\n");
+				usart_default();
 				break;
 			}
 			usart_puts("?\n");
 		}
 		/* Signal reception complete */
 		GPIOA->POUT = 0xaa;
+		/* Report bytes lost during the upload */
+		count = usart_overruns();
+		if (count > 0) {
+			usart_puts("\r\nOverruns: ");
+			printhex(count, 8);
+		}
 	}
 
 	/* Start the simple monitor */
@@ -179,10 +261,17 @@ int main(void) {
 				   " ww <addr> <data> - write data at addr\r\n"
 				   " dw <addr>        - dump 16 words\r\n"
 				   " n                - dump next 16 words"
+#if WITH_MEMCMDS
+				   "\r\n"
+				   " fw <a> <n> <d>   - fill n bytes at a with d\r\n"
+				   " cw <d> <s> <n>   - copy n bytes from s to d\r\n"
+				   " cm <a> <b> <n>   - compare n bytes at a and b\r\n"
+				   " crc <a> <n>      - CRC32 of n bytes at a"
+#endif
 				  );
 		} else if (strcmp(buffer, "r") == 0) {
 			/* Start the application */
-			USART->BAUD = 0;
+			usart_stop();
 			GPIOA->POUT = 0;
 			(*app_start)();
 		} else if (strncmp(buffer, "rw ", 3) == 0) {
@@ -227,7 +316,7 @@ int main(void) {
 					mask = 0xff000000;
 					for (int j = 3; j > -1; j--) {
 						c = (v & mask) >> (j*8);
-						if (isprint(c)) {
+						if (c >= ' ' && c <= '~') {
 							usart_putc(c);
 						} else {
 							usart_putc('.');
@@ -240,6 +329,75 @@ int main(void) {
 			} else {
 				usart_puts("Not on 4-byte boundary!");
 			}
+#if WITH_MEMCMDS
+		} else if (strncmp(buffer, "fw ", 3) == 0) {
+			/* Fill words, prints the end address */
+			char *s;
+			unsigned long n, v;
+			addr = parsehex(buffer+3, &s);
+			n = parsehex(s, &s);
+			v = parsehex(s, NULL);
+			if ((addr & 0x3) == 0) {
+				unsigned long *p = (unsigned long *) addr;
+				for (n = (n + 3) / 4; n > 0; n--) {
+					*p++ = v;
+				}
+				printhex((unsigned long) p, 8);
+			} else {
+				usart_puts("Not on 4-byte boundary!");
+			}
+		} else if (strncmp(buffer, "cw ", 3) == 0) {
+			/* Copy words, overlap allowed, prints the end address */
+			char *s;
+			unsigned long src, n;
+			addr = parsehex(buffer+3, &s);
+			src = parsehex(s, &s);
+			n = (parsehex(s, NULL) + 3) / 4;
+			if (((addr | src) & 0x3) == 0) {
+				unsigned long *d = (unsigned long *) addr;
+				unsigned long *p = (unsigned long *) src;
+				if (d > p) {
+					for (unsigned long i = n; i > 0; i--) {
+						d[i-1] = p[i-1];
+					}
+				} else {
+					for (unsigned long i = 0; i < n; i++) {
+						d[i] = p[i];
+					}
+				}
+				printhex((unsigned long) (d + n), 8);
+			} else {
+				usart_puts("Not on 4-byte boundary!");
+			}
+		} else if (strncmp(buffer, "cm ", 3) == 0) {
+			/* Compare bytes, prints the first difference */
+			char *s;
+			unsigned long n;
+			unsigned char *p, *q;
+			p = (unsigned char *) parsehex(buffer+3, &s);
+			q = (unsigned char *) parsehex(s, &s);
+			n = parsehex(s, NULL);
+			while (n > 0 && *p == *q) {
+				p++;
+				q++;
+				n--;
+			}
+			if (n == 0) {
+				usart_puts("Equal");
+			} else {
+				usart_puts("Differ at ");
+				printhex((unsigned long) p, 8);
+				usart_puts(" ");
+				printhex((unsigned long) q, 8);
+			}
+		} else if (strncmp(buffer, "crc ", 4) == 0) {
+			/* CRC32 of a range, the same as the H command */
+			char *s;
+			unsigned long n;
+			addr = parsehex(buffer+4, &s);
+			n = parsehex(s, NULL);
+			printhex(crc32(0, (unsigned char *) addr, n), 8);
+#endif
 		} else if (len == 0) {
 			/* do nothing */
 		} else {
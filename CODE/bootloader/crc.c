@@ -0,0 +1,23 @@
+/*
+ *
+ * crc.c -- CRC32 for the bootloader
+ *
+ * (c)2022, J.E.J. op den Brouw <J.E.J.opdenBrouw@hhs.nl
+ *
+ */
+
+#include "crc.h"
+
+/* Update CRC32 (IEEE 802.3, reflected) with len bytes from buf.
+ * Bit by bit without a table, to save ROM */
+unsigned long crc32(unsigned long crc, const unsigned char *buf, unsigned long len)
+{
+	crc = ~crc;
+	while (len--) {
+		crc ^= *buf++;
+		for (int i = 0; i < 8; i++) {
+			crc = (crc >> 1) ^ (0xedb88320UL & -(crc & 1));
+		}
+	}
+	return ~crc;
+}
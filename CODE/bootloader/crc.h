@@ -0,0 +1,8 @@
+#ifndef _CRC_H_
+#define _CRC_H_
+
+/* Update CRC32 (IEEE 802.3) with len bytes from buf.
+ * Start with crc = 0, the result can be chained */
+unsigned long crc32(unsigned long crc, const unsigned char *buf, unsigned long len);
+
+#endif
@@ -0,0 +1,67 @@
+/*
+ *
+ * hwload.c -- hardware S-record loader for the bootloader
+ *
+ * (c)2022, J.E.J. op den Brouw <J.E.J.opdenBrouw@hhs.nl
+ *
+ */
+
+/* The hardware loader is entered after the host sends an 'L'
+ * in upload mode. The loader in the FPGA (loader.vhd) decodes
+ * the S-records received by the USART and writes the data to
+ * the ROM by itself. The bootloader only enables the loader
+ * and waits for the end record. No replies are sent per
+ * record, so the host sends the records back to back. When
+ * done, the status and the number of bytes written are
+ * reported. Without the loader in the hardware, the status
+ * reads as zero and ?\n is sent. */
+
+#include "io.h"
+#include "usart.h"
+#include "util.h"
+#include "hwload.h"
+
+/* Run the hardware loader, returns the (updated) start address */
+unsigned long hwload(unsigned long entry)
+{
+	unsigned long start, count;
+	int c;
+
+	LOADER->CTRL = 1;
+	if ((LOADER->STAT & LOADER_ENABLED) == 0) {
+		LOADER->CTRL = 0;
+		usart_puts("?\n");
+		return entry;
+	}
+	usart_puts("L\n");
+
+	/* Wait for the end record, give up if no data is
+	 * written for a while */
+	count = LOADER->CNT;
+	start = TIME;
+	while ((LOADER->STAT & LOADER_DONE) == 0) {
+		if (LOADER->CNT != count) {
+			count = LOADER->CNT;
+			start = TIME;
+		} else if (TIME - start > HWLOAD_TIMEOUT) {
+			break;
+		}
+	}
+	LOADER->CTRL = 0;
+
+	/* The loader stops at the checksum of the end record, the
+	 * rest of the line is received by the processor. Drop it,
+	 * else it is answered with ?\n after the status */
+	while ((c = usart_getc_timeout(HWLOAD_DRAIN)) >= 0 && c != '\n');
+
+	usart_putc('L');
+	printhex(LOADER->STAT, 2);
+	printhex(LOADER->CNT, 8);
+	usart_puts("\n");
+
+	if (LOADER->STAT & LOADER_DONE) {
+		entry = LOADER->START;
+	}
+
+	return entry;
+}
@@ -0,0 +1,21 @@
+#ifndef _HWLOAD_H_
+#define _HWLOAD_H_
+
+/* Status bits of the hardware loader */
+#define LOADER_DONE (0x01)
+#define LOADER_ERR_CHECKSUM (0x02)
+#define LOADER_ERR_FORMAT (0x04)
+#define LOADER_ERR_RANGE (0x08)
+#define LOADER_ENABLED (0x10)
+
+/* Stop waiting if no data is written for this time, in
+ * micro seconds */
+#define HWLOAD_TIMEOUT (2000000UL)
+/* Wait at most this time for the end of the last record, in
+ * micro seconds */
+#define HWLOAD_DRAIN (100000UL)
+
+/* Run the hardware loader, returns the (updated) start address */
+unsigned long hwload(unsigned long entry);
+
+#endif
@@ -51,6 +51,18 @@ typedef struct {
 #define TIMER1 ((TIMER_struct_t *) TIMER1_BASE)
 
 
+/* Hardware S-record loader (in I/O), see loader.vhd */
+typedef struct {
+	volatile uint32_t CTRL;
+	volatile uint32_t STAT;
+	volatile uint32_t CNT;
+	volatile uint32_t START;
+} LOADER_struct_t;
+
+#define LOADER_BASE (IO_BASE+0x000000a0UL)
+#define LOADER ((LOADER_struct_t *) LOADER_BASE)
+
+
 /* RISC-V system timer (in I/O) */
 #define TIME (*(volatile uint32_t*)(IO_BASE+0x000000f0UL))
 #define TIMEH (*(volatile uint32_t*)(IO_BASE+0x000000f4UL))
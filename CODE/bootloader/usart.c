@@ -3,6 +3,8 @@
 #include <ctype.h>
 
 #include "io.h"
+#include "usart.h"
+#include "util.h"
 
 /* Frequency of the DE0-CV board */
 #ifndef F_CPU
@@ -13,11 +15,78 @@
 #define BAUD_RATE (9600UL)
 #endif
 
-/* Initialize the Baud Rate Generator */
+/* Receive ring buffer, filled by the interrupt handler.
+ * The USART holds only one byte, so without the ring the
+ * bootloader must handle each byte before the next one
+ * arrives. Now the main loop may be busy writing memory */
+static volatile unsigned char rxring[USART_RXLEN];
+static volatile unsigned long rxhead, rxtail, rxoverruns;
+
+/* USART receive interrupt. Other traps are not expected,
+ * so these hang the bootloader */
+__attribute__((interrupt))
+void usart_handler(void)
+{
+	unsigned long mcause, next;
+	unsigned char c;
+
+	__asm__ volatile ("csrr %0, mcause" : "=r" (mcause));
+	if (mcause != USART_IN_MCAUSE) {
+		while (1);
+	}
+
+	/* Reading the data clears the interrupt */
+	c = USART->DATA;
+	next = (rxhead + 1) & (USART_RXLEN - 1);
+	if (next == rxtail) {
+		rxoverruns++;
+	} else {
+		rxring[rxhead] = c;
+		rxhead = next;
+	}
+}
+
+/* Initialize the Baud Rate Generator and start the
+ * receive interrupt */
 void usart_init(void)
 {
 	/* Set baud rate generator */
-	USART->BAUD = F_CPU/BAUD_RATE-1;
+	usart_default();
+
+	rxhead = rxtail = rxoverruns = 0;
+	/* Set the handler, direct mode */
+	__asm__ volatile ("csrw mtvec, %0" : : "r" (usart_handler));
+	/* 8N1, receive interrupt enable */
+	USART->CTRL = 0x40;
+	/* Set mstatus.MIE, the LIC interrupts need no mie bit */
+	__asm__ volatile ("csrsi mstatus, 8");
+}
+
+/* Stop the receive interrupt, the application starts
+ * with the USART and interrupts as after reset */
+void usart_stop(void)
+{
+	__asm__ volatile ("csrci mstatus, 8");
+	USART->CTRL = 0;
+	USART->BAUD = 0;
+}
+
+/* Number of bytes lost, cleared after reading */
+unsigned long usart_overruns(void)
+{
+	unsigned long n = rxoverruns;
+
+	rxoverruns = 0;
+	return n;
+}
+
+/* Get a byte from the ring buffer, the ring must not be empty */
+static int rxget(void)
+{
+	int c = rxring[rxtail];
+
+	rxtail = (rxtail + 1) & (USART_RXLEN - 1);
+	return c;
 }
 
 /* Send one character over the USART */
@@ -49,16 +118,88 @@ void usart_puts(char *s)
 int usart_getc(void)
 {
 	/* Wait for received character */
-	while ((USART->STAT & 0x04) == 0);
+	while (rxhead == rxtail);
+
+	return rxget();
+}
+
+/* Get one character from the USART, wait at most
+ * timeout micro seconds. Returns -1 on timeout */
+int usart_getc_timeout(unsigned long timeout)
+{
+	unsigned long start = TIME;
+
+	/* Wait for received character or timeout */
+	while (rxhead == rxtail) {
+		if (TIME - start > timeout) {
+			return -1;
+		}
+	}
+
+	return rxget();
+}
+
+/* Baud rate negotiation with the upload program. Reads the
+ * proposed baud rate as 8 hex digits and a newline. If the
+ * rate can be made, R\n is sent and the USART switches to
+ * the new rate. The upload program then sends the test
+ * pattern which is echoed back. If the pattern is not
+ * received in time, the USART falls back to the old rate */
+void usart_negotiate(void)
+{
+	static const unsigned char pattern[] = BAUD_PATTERN;
+	unsigned long baud, div, old, i;
+
+	/* Read in proposed baud rate and the rest of the line */
+	baud = gethex(8);
+	while (usart_getc() != '\n');
+
+	/* Check the divider and the baud rate error, maximum 2% */
+	div = (baud == 0) ? 0 : (F_CPU + baud/2) / baud;
+	if (div < BAUD_MINDIV || div > 65536 ||
+	    (div*baud > F_CPU ? div*baud - F_CPU : F_CPU - div*baud) > F_CPU/50) {
+		usart_puts("?\n");
+		return;
+	}
 
-	/* Return 8-bit data */
-	return USART->DATA & 0x000000ff;
+	/* Acknowledge at the old rate, then switch */
+	usart_puts("R\n");
+	old = USART->BAUD;
+	USART->BAUD = div - 1;
+
+	/* Check the test pattern at the new rate */
+	for (i = 0; i < sizeof pattern; i++) {
+		if (usart_getc_timeout(BAUD_TIMEOUT) != pattern[i]) {
+			break;
+		}
+	}
+
+	if (i == sizeof pattern) {
+		/* Echo the pattern, the upload program checks it
+		 * and confirms the new rate */
+		for (i = 0; i < sizeof pattern; i++) {
+			usart_putc(pattern[i]);
+		}
+		if (usart_getc_timeout(BAUD_TIMEOUT) == BAUD_CONFIRM) {
+			return;
+		}
+	}
+
+	/* Wait for the line to become idle and fall back */
+	while (usart_getc_timeout(BAUD_TIMEOUT) >= 0);
+	USART->BAUD = old;
+}
+
+/* Set the default baud rate */
+void usart_default(void)
+{
+	USART->BAUD = F_CPU/BAUD_RATE-1;
 }
 
 /* Check if a character is received */
 int usart_received(void)
 {
-	return (USART->STAT & 0x04);
+	return rxhead != rxtail;
 }
 
 /* Gets a string terminated by a newline character from usart
@@ -3,14 +3,40 @@
 #ifndef _USART_H
 #define _USART_H
 
-/* Initialize the USART */
+/* Baud rate negotiation: test pattern exchanged at the new
+ * rate, the byte that confirms the new rate, minimum divider
+ * and timeout in micro seconds */
+#define BAUD_PATTERN { 0x55, 0xaa, 0x00, 0xff, 0x0f, 0xf0, 0x33, 0xcc }
+#define BAUD_CONFIRM (0xa5)
+#define BAUD_MINDIV (16)
+#define BAUD_TIMEOUT (200000UL)
+
+/* Received bytes are placed in a ring buffer by the USART
+ * receive interrupt (LIC interrupt 18). Size must be a
+ * power of 2. 2 KB holds seven binary frames of 268 bytes,
+ * see BIN_WINDOW in binload.h */
+#define USART_RXLEN (2048)
+#define USART_IN_MCAUSE ((1UL<<31)+18)
+
+/* Initialize the USART and start the receive interrupt */
 void usart_init(void);
+/* Stop the receive interrupt, before starting the application */
+void usart_stop(void);
+/* Number of bytes lost because the ring buffer was full,
+ * cleared after reading */
+unsigned long usart_overruns(void);
 /* Write one character to USART */
 void usart_putc(int ch);
 /* Write null-terminated string to USART */
 void usart_puts(char *s);
 /* Get one character from USART */
 int usart_getc(void);
+/* Get one character from USART with timeout in us, -1 on timeout */
+int usart_getc_timeout(unsigned long timeout);
+/* Negotiate a new baud rate with the upload program */
+void usart_negotiate(void);
+/* Return to the default baud rate */
+void usart_default(void);
 /* Check if character is received */
 int usart_received(void);
 /* Get maximum size-1 characters in string buffer from USART */
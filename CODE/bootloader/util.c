@@ -1,24 +1,30 @@
-#include <ctype.h>
+#include <stddef.h>
 
 #include "io.h"
 #include "usart.h"
 
-/* Parse hex string from s, ppchar return position after the hex string */
+/* Parse hex string from s, ppchar return position after the hex string.
+ * No ctype functions are used, they pull in a 256 byte table */
 unsigned long int parsehex(char *s, char **ppchar) {
 
 	unsigned long int v = 0;
+	unsigned long int d;
 
-	while (isspace((int) *s)) {
+	while (*s == ' ') {
 		s++;
 	}
 
-	while (isxdigit((int) *s)) {
-		v <<= 4;
-		if (isdigit((int) *s)) {
-			v |= *s - '0';
-		} else {
-			v |= tolower(*s) - 'a' + 10;
+	while (1) {
+		d = *s - '0';
+		if (d > 9) {
+			/* Lower case, then 'a'-'f' */
+			d = (*s | 0x20) - 'a';
+			if (d > 5) {
+				break;
+			}
+			d += 10;
 		}
+		v = (v << 4) | d;
 		s++;
 	}
 
@@ -31,34 +37,78 @@ unsigned long int parsehex(char *s, char **ppchar) {
 
 /* Print hex string, n is number of hex characters */
 void printhex(unsigned long int v, int n) {
-	char buf[9] = { 0 };
 
 	if (n < 1 || n > 8) {
 		n = 8;
 	}
-	for (int i = 0; i < n; i++) {
-		unsigned char c = (v & 0x0f) + '0';
+	while (n-- > 0) {
+		unsigned char c = ((v >> (n*4)) & 0x0f) + '0';
 		if (c > '9') {
 			c += 'a' - '0' - 10;
 		}
-		buf[n-1-i] = c;
-		v >>= 4;
+		usart_putc(c);
 	}
-	usart_puts(buf);
 }
 
+/* Value of a hex digit, indexed by the lower 5 bits of
+ * the character: '0'-'9' are 0x10-0x19, 'A'-'F' and 'a'-'f'
+ * are 0x01-0x06. Other characters are not checked */
+static const unsigned char hexval[32] = {
+	0, 10, 11, 12, 13, 14, 15, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0,  1,  2,  3,  4,  5,  6, 7, 8, 9, 0, 0, 0, 0, 0, 0
+};
+
+/* Get a hex number of n digits from the USART */
 unsigned long int gethex(int n) {
 
 	unsigned long int v = 0;
 	
 	for (int i = 0; i < n; i++) {
-		int c = usart_getc();
-		v <<= 4;
-		if (isdigit(c)) {
-			v |= c - '0';
-		} else if (isxdigit(c)) {
-			v |= tolower(c) - 'a' + 10;
-		}
+		v = (v << 4) | hexval[usart_getc() & 0x1f];
 	}
 	return v;
 }
+
+/* Word writer. The ROM can only be written with words, so
+ * bytes are collected in a word and each word is written once.
+ * Bytes before the start address and after the last byte
+ * are kept */
+static unsigned long wraddr, wrword;
+
+void wr_start(unsigned long addr)
+{
+	wraddr = addr;
+	wrword = *(unsigned long *) (addr & ~3);
+}
+
+void wr_put(unsigned long byte)
+{
+	unsigned long shift = (wraddr & 3) * 8;
+
+	wrword = (wrword & ~(0xffUL << shift)) | (byte << shift);
+	wraddr++;
+	if ((wraddr & 3) == 0) {
+		*(unsigned long *) (wraddr - 4) = wrword;
+	}
+}
+
+/* Get the byte written off bytes back */
+unsigned long wr_get(unsigned long off)
+{
+	unsigned long addr = wraddr - off;
+
+	/* Byte may be in the word not yet written */
+	if ((addr & ~3) == (wraddr & ~3)) {
+		return (wrword >> ((addr & 3) * 8)) & 0xff;
+	}
+	return *(unsigned char *) addr;
+}
+
+void wr_flush(void)
+{
+	if (wraddr & 3) {
+		unsigned long *boun = (unsigned long *) (wraddr & ~3);
+		unsigned long mask = (1UL << ((wraddr & 3) * 8)) - 1;
+		*boun = (*boun & ~mask) | (wrword & mask);
+	}
+}
@@ -8,6 +8,12 @@ unsigned long int parsehex(char *s, char **ppchar);
 void printhex(unsigned long int v, int n);
 /* Get a hex number from the USART */
 unsigned long int gethex(int n);
+/* Word writer: start at addr, put bytes, flush the last word */
+void wr_start(unsigned long addr);
+void wr_put(unsigned long byte);
+/* Get the byte written off bytes back */
+unsigned long wr_get(unsigned long off);
+void wr_flush(void);
 
 
 #endif
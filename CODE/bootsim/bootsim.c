@@ -0,0 +1,752 @@
+/*
+ * bootsim - bootloader simulator on a pseudo terminal
+ *
+ * (c)2022, J.E.J. op den Brouw <J.E.J.opdenBrouw@hhs.nl>
+ *
+ * This program opens a pseudo terminal and implements the
+ * upload protocol of the bootloader, so that the upload
+ * program can be tested and tuned without hardware.
+ *
+ * Supported: !, S-records, B (binary frames), R (baud rate
+ * negotiation), H (block CRCs), G (read back), L (hardware
+ * loader), J and #. The monitor is not simulated, # ends the
+ * session.
+ *
+ * Options:
+ *      -b <baud>  Model the line speed (start rate), default no pacing
+ *      -p <us>    Processing delay per received byte
+ *      -l <link>  Create a symbolic link to the device
+ *      -o <file>  Write the received data as S-records
+ *      -e <n>     Corrupt every n-th read back frame
+ *      -n <cmd>   Leave out baud, crc, read or hwload
+ *      -B         Benchmark, report throughput and keep running
+ *      -v         Verbose output
+ *
+ * ROM (64 KB at 0x00000000) and RAM (32 KB at 0x20000000) are
+ * simulated. The memory is kept between sessions, as on the
+ * target, so delta uploads can be tested.
+ *
+ * */
+
+#define _XOPEN_SOURCE 600
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <sys/select.h>
+#include <sys/time.h>
+
+#define VERSION "v0.1"
+
+/* Simulated memories */
+#define ROM_ADDR (0x00000000UL)
+#define ROM_SIZE (65536)
+#define RAM_ADDR (0x20000000UL)
+#define RAM_SIZE (32768)
+
+/* Processor clock, for the baud rate divider */
+#define F_CPU (50000000UL)
+
+/* Binary transfer, see bootloader/binload.h */
+#define BIN_HDRLEN (8)
+#define BIN_MAXLEN (256)
+#define BIN_TIMEOUT (100000)
+#define BIN_WINDOW (8)
+#define BIN_DATA 'D'
+#define BIN_PACKED 'C'
+#define BIN_ENTRY 'E'
+#define BIN_END 'Z'
+#define BIN_ACK 'A'
+#define BIN_NAK 'N'
+#define BIN_ERR_CRC (-1)
+#define BIN_ERR_SYNC (-2)
+
+/* Baud rate negotiation, see bootloader/usart.h */
+#define BAUD_PATTERN { 0x55, 0xaa, 0x00, 0xff, 0x0f, 0xf0, 0x33, 0xcc }
+#define BAUD_CONFIRM (0xa5)
+#define BAUD_MINDIV (16)
+#define BAUD_TIMEOUT (200000)
+
+/* Hardware loader, see bootloader/hwload.h */
+#define HWLOAD_DRAIN (100000)
+
+/* The pseudo terminal */
+static int fd;
+
+/* Options */
+static int verbose = 0;
+static long line_baud = 0;
+static long procdelay = 0;
+static long errorrate = 0;
+
+/* Optional commands, as WITH_* of the bootloader, all are
+ * included by default. A command that is left out is
+ * answered with ?\n */
+static int with_baud = 1;
+static int with_crc = 1;
+static int with_read = 1;
+static int with_hwload = 1;
+
+/* Memory, and which bytes are written */
+static unsigned char rom[ROM_SIZE], rom_written[ROM_SIZE];
+static unsigned char ram[RAM_SIZE], ram_written[RAM_SIZE];
+
+/* Statistics of a session */
+static unsigned long rx_bytes, tx_bytes, mem_bytes, bad_bytes, naks;
+
+/* Line pacing: the current baud rate, 0 is no pacing,
+ * and the time the last byte was received */
+static long baud;
+static double line_time;
+
+/* CRC32 (IEEE 802.3) lookup table */
+static uint32_t crc_table[256];
+
+static void crc32_init(void)
+{
+	for (uint32_t i = 0; i < 256; i++) {
+		uint32_t c = i;
+		for (int k = 0; k < 8; k++) {
+			c = (c & 1) ? 0xedb88320UL ^ (c >> 1) : c >> 1;
+		}
+		crc_table[i] = c;
+	}
+}
+
+static uint32_t crc32(uint32_t crc, const unsigned char *buf, size_t len)
+{
+	crc = ~crc;
+	while (len--) {
+		crc = crc_table[(crc ^ *buf++) & 0xff] ^ (crc >> 8);
+	}
+	return ~crc;
+}
+
+/* Current time in seconds */
+static double now(void)
+{
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/* Wait until time t */
+static void wait_until(double t)
+{
+	double d = t - now();
+
+	if (d > 0) {
+		usleep(d * 1e6);
+	}
+}
+
+/* Time of one character on the line, 10 bits */
+static double char_time(void)
+{
+	return baud > 0 ? 10.0 / baud : 0.0;
+}
+
+/* Get a byte, with timeout in micro seconds, 0 is no timeout.
+ * Returns -1 on timeout. When pacing, bytes are not received
+ * faster than the line speed */
+static int getbyte(long timeout)
+{
+	struct timeval tv = { timeout / 1000000, timeout % 1000000 };
+	unsigned char c;
+	fd_set fds;
+
+	while (1) {
+		FD_ZERO(&fds);
+		FD_SET(fd, &fds);
+		if (select(fd+1, &fds, NULL, NULL, timeout ? &tv : NULL) <= 0) {
+			return -1;
+		}
+		if (read(fd, &c, 1) == 1) {
+			break;
+		}
+	}
+
+	if (baud > 0) {
+		double t = now();
+		line_time = (line_time + char_time() > t) ? line_time + char_time() : t;
+		wait_until(line_time);
+	}
+	if (procdelay > 0) {
+		usleep(procdelay);
+	}
+	rx_bytes++;
+
+	return c;
+}
+
+/* Send bytes, the transmitter waits for each character */
+static void putbytes(const void *buf, size_t len)
+{
+	if (write(fd, buf, len) < 0) {
+		perror("write");
+	}
+	tx_bytes += len;
+	if (baud > 0) {
+		usleep(len * char_time() * 1e6);
+	}
+}
+
+static void putstr(const char *s)
+{
+	putbytes(s, strlen(s));
+}
+
+/* Get a hex number of n digits, as the bootloader does */
+static uint32_t gethex(int n)
+{
+	uint32_t v = 0;
+
+	for (int i = 0; i < n; i++) {
+		int c = getbyte(0);
+		v <<= 4;
+		if (c >= '0' && c <= '9') {
+			v |= c - '0';
+		} else if (c >= 'a' && c <= 'f') {
+			v |= c - 'a' + 10;
+		} else if (c >= 'A' && c <= 'F') {
+			v |= c - 'A' + 10;
+		}
+	}
+	return v;
+}
+
+/* Find the simulated memory of an address, NULL if none */
+static unsigned char *memptr(uint32_t addr, unsigned char **written)
+{
+	if (addr - ROM_ADDR < ROM_SIZE) {
+		*written = &rom_written[addr - ROM_ADDR];
+		return &rom[addr - ROM_ADDR];
+	}
+	if (addr - RAM_ADDR < RAM_SIZE) {
+		*written = &ram_written[addr - RAM_ADDR];
+		return &ram[addr - RAM_ADDR];
+	}
+	return NULL;
+}
+
+static void memwrite(uint32_t addr, unsigned char byte)
+{
+	unsigned char *w, *p = memptr(addr, &w);
+
+	if (p == NULL) {
+		bad_bytes++;
+		return;
+	}
+	*p = byte;
+	*w = 1;
+	mem_bytes++;
+}
+
+static unsigned char memread(uint32_t addr)
+{
+	unsigned char *w, *p = memptr(addr, &w);
+
+	return p ? *p : 0;
+}
+
+/* Process one S-record, the S is already read. Returns 1
+ * for an end record. As the hardware loader, hw stops at the
+ * checksum of an end record */
+static int srecord(uint32_t *entry, int hw)
+{
+	int c = getbyte(0);
+	uint32_t count, addr;
+	int end = 0;
+
+	if (c == '1' || c == '2' || c == '3') {
+		int alen = c - '0' + 1;
+		count = gethex(2) - alen - 1;
+		addr = gethex(alen * 2);
+		for (uint32_t i = 0; i < count; i++) {
+			memwrite(addr++, gethex(2));
+		}
+	} else if (c == '7' || c == '8' || c == '9') {
+		gethex(2);
+		*entry = gethex(('9' - c + 2) * 2);
+		end = 1;
+		if (hw) {
+			gethex(2);
+			return end;
+		}
+	}
+	/* Read in rest of line */
+	while ((c = getbyte(0)) != '\n' && c >= 0);
+
+	return end;
+}
+
+/* Receive a binary frame, returns the payload length or an error */
+static long getframe(unsigned char *frame)
+{
+	uint32_t len, i;
+	int c;
+
+	frame[0] = getbyte(0);
+	for (i = 1; i < BIN_HDRLEN; i++) {
+		if ((c = getbyte(BIN_TIMEOUT)) < 0) {
+			return BIN_ERR_SYNC;
+		}
+		frame[i] = c;
+	}
+	len = frame[2] | (frame[3] << 8);
+	if (len > BIN_MAXLEN) {
+		return BIN_ERR_SYNC;
+	}
+	if (frame[0] != BIN_DATA && frame[0] != BIN_PACKED &&
+	    frame[0] != BIN_ENTRY && frame[0] != BIN_END) {
+		return BIN_ERR_SYNC;
+	}
+	for (; i < BIN_HDRLEN + len + 4; i++) {
+		if ((c = getbyte(BIN_TIMEOUT)) < 0) {
+			return BIN_ERR_SYNC;
+		}
+		frame[i] = c;
+	}
+	if (crc32(0, frame, BIN_HDRLEN + len) !=
+	    (frame[i-4] | (frame[i-3] << 8) | (frame[i-2] << 16) | ((uint32_t) frame[i-1] << 24))) {
+		return BIN_ERR_CRC;
+	}
+	return len;
+}
+
+/* Decompress a compressed frame, see bootloader/binload.c */
+static void unpack(uint32_t addr, unsigned char *p, uint32_t len)
+{
+	unsigned char *end = p + len;
+	uint32_t n, off;
+
+	while (p < end) {
+		n = *p++;
+		if (n < 0x80) {
+			for (n++; n > 0 && p < end; n--) {
+				memwrite(addr++, *p++);
+			}
+		} else if (p + 2 <= end) {
+			off = p[0] | (p[1] << 8);
+			p += 2;
+			for (n = (n & 0x7f) + 3; n > 0; n--, addr++) {
+				memwrite(addr, memread(addr - off));
+			}
+		} else {
+			break;
+		}
+	}
+}
+
+/* Binary transfer, until the end frame is received */
+static void binload(uint32_t *entry)
+{
+	static unsigned char frame[BIN_HDRLEN+BIN_MAXLEN+4];
+	unsigned char resp[2];
+	long len;
+
+	while (1) {
+		len = getframe(frame);
+		if (len == BIN_ERR_SYNC) {
+			while (getbyte(BIN_TIMEOUT) >= 0);
+		}
+		resp[1] = frame[1];
+		if (len < 0) {
+			resp[0] = BIN_NAK;
+			putbytes(resp, 2);
+			naks++;
+			continue;
+		}
+		uint32_t addr = frame[4] | (frame[5] << 8) | (frame[6] << 16) | ((uint32_t) frame[7] << 24);
+		switch (frame[0]) {
+			case BIN_DATA:
+				for (long i = 0; i < len; i++) {
+					memwrite(addr + i, frame[BIN_HDRLEN+i]);
+				}
+				break;
+			case BIN_PACKED:
+				unpack(addr, frame+BIN_HDRLEN, len);
+				break;
+			case BIN_ENTRY:
+				*entry = addr;
+				break;
+			default:
+				break;
+		}
+		resp[0] = BIN_ACK;
+		putbytes(resp, 2);
+		if (frame[0] == BIN_END) {
+			return;
+		}
+	}
+}
+
+/* Baud rate negotiation, the R is acknowledged */
+static void negotiate(void)
+{
+	static const unsigned char pattern[] = BAUD_PATTERN;
+	uint32_t rate, div;
+	size_t i;
+	int c;
+
+	rate = gethex(8);
+	while ((c = getbyte(0)) != '\n' && c >= 0);
+
+	div = (rate == 0) ? 0 : (F_CPU + rate/2) / rate;
+	if (div < BAUD_MINDIV || div > 65536 ||
+	    labs((long) (div*rate) - (long) F_CPU) > (long) F_CPU/50) {
+		putstr("?\n");
+		return;
+	}
+	putstr("R\n");
+
+	for (i = 0; i < sizeof pattern; i++) {
+		if (getbyte(BAUD_TIMEOUT) != pattern[i]) {
+			break;
+		}
+	}
+	if (i == sizeof pattern) {
+		putbytes(pattern, sizeof pattern);
+		if (getbyte(BAUD_TIMEOUT) == BAUD_CONFIRM) {
+			if (baud > 0) {
+				baud = rate;
+			}
+			if (verbose) {
+				printf("Baud rate %u\n", rate);
+			}
+			return;
+		}
+	}
+	while (getbyte(BAUD_TIMEOUT) >= 0);
+}
+
+/* Block CRCs, the H is acknowledged */
+static void blockcrc(void)
+{
+	uint32_t addr = gethex(8), len = gethex(8), size = gethex(8);
+	unsigned char buf[256];
+	char hex[10];
+
+	while (len > 0 && size > 0) {
+		uint32_t n = len < size ? len : size;
+		uint32_t crc = 0;
+		for (uint32_t done = 0; done < n; ) {
+			uint32_t k = n - done < sizeof buf ? n - done : sizeof buf;
+			for (uint32_t i = 0; i < k; i++) {
+				buf[i] = memread(addr + done + i);
+			}
+			crc = crc32(crc, buf, k);
+			done += k;
+		}
+		sprintf(hex, "%08x", crc);
+		putstr(hex);
+		addr += n;
+		len -= n;
+	}
+	putstr("\n");
+}
+
+/* Hardware loader, the L is acknowledged. The S-records are
+ * received without replies up to the end record, then the
+ * status and the number of bytes written are reported */
+static void hwload(uint32_t *entry)
+{
+	unsigned long start = mem_bytes;
+	char reply[16];
+	int c;
+
+	do {
+		while ((c = getbyte(0)) != 'S') {
+			if (c < 0) {
+				return;
+			}
+		}
+	} while (!srecord(entry, 1));
+
+	/* The bootloader drops the rest of the end record */
+	while ((c = getbyte(HWLOAD_DRAIN)) >= 0 && c != '\n');
+
+	sprintf(reply, "L01%08lX\n", mem_bytes - start);
+	putstr(reply);
+}
+
+/* Send the memory in frames, the G is acknowledged. With -e,
+ * the CRC of every n-th data frame is corrupted */
+static void readback(void)
+{
+	static unsigned long frames;
+	uint32_t addr = gethex(8), len = gethex(8);
+	unsigned char frame[BIN_HDRLEN+BIN_MAXLEN+4];
+	int seq = 0;
+
+	/* The end frame has no payload */
+	while (1) {
+		uint32_t n = len < BIN_MAXLEN ? len : BIN_MAXLEN;
+		uint32_t crc;
+
+		frame[0] = n > 0 ? BIN_DATA : BIN_END;
+		frame[1] = seq++;
+		frame[2] = n;
+		frame[3] = n >> 8;
+		for (int i = 0; i < 4; i++) {
+			frame[4+i] = addr >> (8*i);
+		}
+		for (uint32_t i = 0; i < n; i++) {
+			frame[BIN_HDRLEN+i] = memread(addr + i);
+		}
+		crc = crc32(0, frame, BIN_HDRLEN + n);
+		if (n > 0 && errorrate > 0 && ++frames % errorrate == 0) {
+			crc ^= 1;
+		}
+		for (int i = 0; i < 4; i++) {
+			frame[BIN_HDRLEN+n+i] = crc >> (8*i);
+		}
+		putbytes(frame, BIN_HDRLEN + n + 4);
+		addr += n;
+		len -= n;
+		if (n == 0) {
+			break;
+		}
+	}
+}
+
+/* Write the written memory as S3 records */
+static int dump_srec(const char *name, uint32_t entry)
+{
+	FILE *fout = fopen(name, "w");
+
+	if (fout == NULL) {
+		fprintf(stderr, "Cannot open output file %s\n", name);
+		return -1;
+	}
+
+	for (int m = 0; m < 2; m++) {
+		uint32_t base = m ? RAM_ADDR : ROM_ADDR;
+		uint32_t size = m ? RAM_SIZE : ROM_SIZE;
+		unsigned char *data = m ? ram : rom, *written = m ? ram_written : rom_written;
+
+		for (uint32_t off = 0; off < size; ) {
+			int n = 0, sum;
+			uint32_t addr;
+
+			if (!written[off]) {
+				off++;
+				continue;
+			}
+			while (n < 16 && off + n < size && written[off+n]) {
+				n++;
+			}
+			addr = base + off;
+			sum = n + 5 + (addr >> 24) + (addr >> 16) + (addr >> 8) + addr;
+			fprintf(fout, "S3%02X%08X", n + 5, addr);
+			for (int i = 0; i < n; i++) {
+				fprintf(fout, "%02X", data[off+i]);
+				sum += data[off+i];
+			}
+			fprintf(fout, "%02X\n", ~sum & 0xff);
+			off += n;
+		}
+	}
+	fprintf(fout, "S705%08X%02X\n", entry,
+		~(5 + (entry >> 24) + (entry >> 16) + (entry >> 8) + entry) & 0xff);
+
+	fclose(fout);
+	return 0;
+}
+
+/* Run one upload session, from the ! up to J or #. The
+ * time of the ! is returned in start. Returns -1 if the
+ * device fails */
+static int session(uint32_t *entry, double *start)
+{
+	int c;
+	char reply[8];
+
+	/* Wait for the upload program */
+	while ((c = getbyte(0)) != '!') {
+		if (c < 0) {
+			return -1;
+		}
+	}
+	*start = now();
+	putstr("?\n");
+
+	while (1) {
+		c = getbyte(0);
+		if (c == 'S') {
+			srecord(entry, 0);
+		} else if (c == 'B') {
+			sprintf(reply, "B%02X\n", BIN_WINDOW);
+			putstr(reply);
+			binload(entry);
+			continue;
+		} else if (c == 'R' && with_baud) {
+			putstr("R\n");
+			negotiate();
+			continue;
+		} else if (c == 'H' && with_crc) {
+			putstr("H\n");
+			blockcrc();
+			continue;
+		} else if (c == 'L' && with_hwload) {
+			putstr("L\n");
+			hwload(entry);
+			continue;
+		} else if (c == 'G' && with_read) {
+			putstr("G\n");
+			readback();
+			continue;
+		} else if (c == 'J' || c == '#') {
+			/* The application or the monitor starts
+			 * with a new line */
+			putstr("\r\n");
+			if (verbose) {
+				printf(c == 'J' ? "Start application at %08x\n" : "Monitor, entry is %08x\n", *entry);
+			}
+			return 0;
+		} else if (c < 0) {
+			return -1;
+		}
+		putstr("?\n");
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	char *linkname = NULL;
+	char *outname = NULL;
+	int bench = 0;
+	int opt;
+	int sfd;
+	uint32_t entry = 0;
+	struct termios tty;
+
+	while ((opt = getopt(argc, argv, "b:p:l:o:e:n:Bv")) != -1) {
+		switch (opt) {
+			case 'b':
+				line_baud = atol(optarg);
+				break;
+			case 'p':
+				procdelay = atol(optarg);
+				break;
+			case 'l':
+				linkname = optarg;
+				break;
+			case 'o':
+				outname = optarg;
+				break;
+			case 'e':
+				errorrate = atol(optarg);
+				break;
+			case 'n':
+				if (strcmp(optarg, "baud") == 0) {
+					with_baud = 0;
+				} else if (strcmp(optarg, "crc") == 0) {
+					with_crc = 0;
+				} else if (strcmp(optarg, "read") == 0) {
+					with_read = 0;
+				} else if (strcmp(optarg, "hwload") == 0) {
+					with_hwload = 0;
+				} else {
+					fprintf(stderr, "Unknown command %s\n", optarg);
+					exit(EXIT_FAILURE);
+				}
+				break;
+			case 'B':
+				bench = 1;
+				break;
+			case 'v':
+				verbose = 1;
+				break;
+			default:
+				fprintf(stderr, "bootsim " VERSION " -- bootloader simulator\n");
+				fprintf(stderr, "Usage: bootsim [-vB -b <baud> -p <us> -l <link> -o <file> -e <n> -n <cmd>]\n");
+				fprintf(stderr, "   -b <baud>  Model the line speed, default no pacing\n");
+				fprintf(stderr, "   -p <us>    Processing delay per received byte\n");
+				fprintf(stderr, "   -l <link>  Create a symbolic link to the device\n");
+				fprintf(stderr, "   -o <file>  Write the received data as S-records\n");
+				fprintf(stderr, "   -e <n>     Corrupt every n-th read back frame\n");
+				fprintf(stderr, "   -n <cmd>   Leave out baud, crc, read or hwload\n");
+				fprintf(stderr, "   -B         Benchmark, report throughput and keep running\n");
+				fprintf(stderr, "   -v         Verbose\n");
+				exit(EXIT_FAILURE);
+		}
+	}
+
+	/* Open the pseudo terminal in raw mode */
+	fd = posix_openpt(O_RDWR | O_NOCTTY);
+	if (fd < 0 || grantpt(fd) < 0 || unlockpt(fd) < 0) {
+		perror("posix_openpt");
+		exit(EXIT_FAILURE);
+	}
+	tcgetattr(fd, &tty);
+	cfmakeraw(&tty);
+	tcsetattr(fd, TCSANOW, &tty);
+
+	/* Keep the slave open, so the pseudo terminal stays
+	 * alive between uploads */
+	sfd = open(ptsname(fd), O_RDWR | O_NOCTTY);
+	if (sfd < 0) {
+		perror("open");
+		exit(EXIT_FAILURE);
+	}
+
+	if (linkname != NULL) {
+		unlink(linkname);
+		if (symlink(ptsname(fd), linkname) < 0) {
+			perror("symlink");
+			exit(EXIT_FAILURE);
+		}
+	}
+	printf("%s\n", ptsname(fd));
+	fflush(stdout);
+
+	crc32_init();
+
+	do {
+		double start;
+
+		rx_bytes = tx_bytes = mem_bytes = bad_bytes = naks = 0;
+		/* The bootloader starts at the default baud rate */
+		baud = line_baud;
+		line_time = 0.0;
+
+		if (session(&entry, &start) < 0) {
+			break;
+		}
+
+		double elapsed = now() - start;
+		if (bench || verbose) {
+			printf("%lu bytes written in %.3f s, %.0f bytes/s, %lu received, %lu sent",
+			       mem_bytes, elapsed, elapsed > 0 ? mem_bytes / elapsed : 0.0, rx_bytes, tx_bytes);
+			if (naks) {
+				printf(", %lu NAKs", naks);
+			}
+			if (bad_bytes) {
+				printf(", %lu bytes outside memory", bad_bytes);
+			}
+			printf("\n");
+			fflush(stdout);
+		}
+		if (outname != NULL && dump_srec(outname, entry) < 0) {
+			exit(EXIT_FAILURE);
+		}
+	} while (bench);
+
+	/* Give the upload program time to read the last reply */
+	usleep(500000);
+
+	if (linkname != NULL) {
+		unlink(linkname);
+	}
+	close(sfd);
+	close(fd);
+
+	return 0;
+}
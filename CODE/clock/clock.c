@@ -4,42 +4,7 @@
 #include <stdint.h>
 #include <inttypes.h>
 #include "io.h"
-
-/* Frequency of the DE0-CV board */
-#define F_CPU (50000000UL)
-/* Transmission speed */
-#define BAUD_RATE (9600ULL)
-
-/* Initialize the Baud Rate Generator */
-void usart_init(void)
-{
-        /* Set baud rate generator */
-        USART->BAUD = F_CPU/BAUD_RATE-1;
-}
-
-/* Send one character over the USART */
-void usart_putc(int ch)
-{
-        /* Transmit data */
-        USART->DATA = (uint8_t) ch;
-
-        /* Wait for transmission end */
-        while ((USART->STAT & 0x10) == 0);
-}
-
-/* Send a null-terminated string over the USART */
-void usart_puts(char *s)
-{
-        if (s == NULL)
-        {
-                return;
-        }
-
-        while (*s != '\0')
-        {
-                usart_putc(*s++);
-        }
-}
+#include "usart.h"
 
 int main(void)
 {
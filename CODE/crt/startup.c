@@ -16,6 +16,14 @@ extern uint8_t _sdata, _edata;
 extern uint8_t _start_of_rom_to_copy;
 extern uint8_t _srodata, _erodata;
 
+/* The RAM image of a fresh bitstream (ram_init_file in
+ * processor_common.vhd) holds the initialized data, with
+ * this flag set. Then the data need not be copied from ROM.
+ * The flag is cleared, so a reset copies the data again. */
+#define RAM_PRELOADED (0x52414d49)
+__attribute__((section(".data.ram_preloaded")))
+volatile uint32_t _ram_preloaded = RAM_PRELOADED;
+
 /* Declare the `main' function */
 int main(void);
 
@@ -60,14 +68,18 @@ void _start(void)
 		*pStart++;
 	}
 
-	/* Copy the ROM-placed RAM init data to the RAM */
-	pStart = &_sdata;
-       	pEnd = &_edata;
-	while (pStart < pEnd) {
-		*pStart = *pdRom;
-		pStart++;
-		pdRom++;
+	/* Copy the ROM-placed RAM init data to the RAM,
+	 * unless the RAM is preloaded */
+	if (_ram_preloaded != RAM_PRELOADED) {
+		pStart = &_sdata;
+		pEnd = &_edata;
+		while (pStart < pEnd) {
+			*pStart = *pdRom;
+			pStart++;
+			pdRom++;
+		}
 	}
+	_ram_preloaded = 0;
 
         /* Initialize the C library */
         __libc_init_array();
@@ -0,0 +1,195 @@
+/*
+ * srec.c -- Motorola S-record reader
+ *
+ * (c)2022, J.E.J. op den Brouw <J.E.J.opdenBrouw@hhs.nl>
+ *
+ * Reads S-records from a file in large blocks, decodes the
+ * hex digits with a lookup table and checks the count and
+ * the checksum of every record.
+ *
+ * Recognized S-records: S0 to S9. S4 is returned without
+ * address and data.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "srec.h"
+
+/* Value of a hex digit, 0x80 if not a hex digit */
+#define X (0x80)
+static const unsigned char hexval[256] = {
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+	0, 1, 2, 3, 4, 5, 6, 7, 8, 9, X, X, X, X, X, X,
+	X,10,11,12,13,14,15, X, X, X, X, X, X, X, X, X,
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+	X,10,11,12,13,14,15, X, X, X, X, X, X, X, X, X,
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X
+};
+#undef X
+
+/* Number of address bytes per record type, S4 has none */
+static const int addrlen[10] = { 2, 2, 3, 4, 0, 2, 3, 4, 3, 2 };
+
+int srec_open(srec_reader_t *r, const char *name)
+{
+	r->fp = fopen(name, "rb");
+	if (r->fp == NULL) {
+		return -1;
+	}
+	r->buf = malloc(SREC_BUFLEN);
+	if (r->buf == NULL) {
+		fclose(r->fp);
+		return -1;
+	}
+	r->len = 0;
+	r->pos = 0;
+	r->eof = 0;
+	r->line = 0;
+
+	return 0;
+}
+
+void srec_close(srec_reader_t *r)
+{
+	fclose(r->fp);
+	free(r->buf);
+}
+
+/* Get the next line from the buffer, without the line end.
+ * Returns SREC_OK, SREC_EOF or an error */
+static int nextline(srec_reader_t *r, unsigned char **line, size_t *len)
+{
+	unsigned char *nl;
+	size_t n;
+
+	while ((nl = memchr(r->buf + r->pos, '\n', r->len - r->pos)) == NULL && !r->eof) {
+		/* Keep the partial line and fill the buffer */
+		memmove(r->buf, r->buf + r->pos, r->len - r->pos);
+		r->len -= r->pos;
+		r->pos = 0;
+		if (r->len == SREC_BUFLEN) {
+			/* No line end in the whole buffer */
+			r->len = 0;
+			r->line++;
+			return SREC_ERR_LINE;
+		}
+		n = fread(r->buf + r->len, 1, SREC_BUFLEN - r->len, r->fp);
+		if (n == 0) {
+			if (ferror(r->fp)) {
+				return SREC_ERR_READ;
+			}
+			r->eof = 1;
+		}
+		r->len += n;
+	}
+
+	if (nl == NULL) {
+		/* Last line without line end */
+		if (r->pos == r->len) {
+			return SREC_EOF;
+		}
+		nl = r->buf + r->len;
+	}
+
+	*line = r->buf + r->pos;
+	*len = nl - *line;
+	r->pos = (nl - r->buf) + (nl < r->buf + r->len);
+	r->line++;
+
+	/* Strip CR and trailing white space */
+	while (*len > 0 && (*line)[*len-1] <= ' ') {
+		(*len)--;
+	}
+
+	return SREC_OK;
+}
+
+int srec_read(srec_reader_t *r, srec_t *rec)
+{
+	unsigned char bytes[256];
+	unsigned char *line, *p;
+	unsigned char bad = 0;
+	unsigned int sum = 0;
+	size_t len;
+	int count, alen, ret;
+
+	ret = nextline(r, &line, &len);
+	if (ret != SREC_OK) {
+		return ret;
+	}
+
+	if (len < 2 || line[0] != 'S') {
+		return SREC_ERR_NOTSREC;
+	}
+	if (line[1] < '0' || line[1] > '9') {
+		return SREC_ERR_TYPE;
+	}
+	rec->type = line[1] - '0';
+
+	/* The count must match the number of hex digits */
+	if (len < 4 || (len & 1)) {
+		return SREC_ERR_LENGTH;
+	}
+	if ((hexval[line[2]] | hexval[line[3]]) & 0x80) {
+		return SREC_ERR_HEX;
+	}
+	count = (hexval[line[2]] << 4) | hexval[line[3]];
+	if ((int) (len - 4) / 2 != count) {
+		return SREC_ERR_LENGTH;
+	}
+
+	/* Decode address, data and checksum, check for bad
+	 * digits once at the end */
+	sum = count;
+	p = line + 4;
+	for (int i = 0; i < count; i++, p += 2) {
+		bad |= hexval[p[0]] | hexval[p[1]];
+		bytes[i] = (hexval[p[0]] << 4) | hexval[p[1]];
+		sum += bytes[i];
+	}
+	if (bad & 0x80) {
+		return SREC_ERR_HEX;
+	}
+	if ((sum & 0xff) != 0xff) {
+		return SREC_ERR_CHECKSUM;
+	}
+
+	alen = addrlen[rec->type];
+	if (count < alen + 1) {
+		return SREC_ERR_LENGTH;
+	}
+	rec->address = 0;
+	for (int i = 0; i < alen; i++) {
+		rec->address = (rec->address << 8) | bytes[i];
+	}
+	rec->len = count - alen - 1;
+	memcpy(rec->data, bytes + alen, rec->len);
+
+	return SREC_OK;
+}
+
+const char *srec_strerror(int err)
+{
+	switch (err) {
+		case SREC_ERR_NOTSREC:	return "Not an S-record";
+		case SREC_ERR_HEX:	return "Invalid hex digit";
+		case SREC_ERR_LENGTH:	return "Count does not match length";
+		case SREC_ERR_CHECKSUM:	return "Checksum error";
+		case SREC_ERR_TYPE:	return "Invalid S-record type";
+		case SREC_ERR_LINE:	return "Line too long";
+		case SREC_ERR_READ:	return "Read error";
+		default:		return "Unknown error";
+	}
+}
@@ -0,0 +1,58 @@
+/*
+ * srec.h -- Motorola S-record reader
+ *
+ * (c)2022, J.E.J. op den Brouw <J.E.J.opdenBrouw@hhs.nl>
+ *
+ */
+
+#ifndef _SREC_H_
+#define _SREC_H_
+
+#include <stdio.h>
+
+/* Size of the input buffer, the file is read in large blocks */
+#define SREC_BUFLEN (1024*1024)
+/* Longest line: S, type, 255 bytes as hex and a CR/LF */
+#define SREC_MAXLINE (2+2*255+2)
+
+/* Return values of srec_read */
+#define SREC_EOF (0)
+#define SREC_OK (1)
+#define SREC_ERR_NOTSREC (-1)
+#define SREC_ERR_HEX (-2)
+#define SREC_ERR_LENGTH (-3)
+#define SREC_ERR_CHECKSUM (-4)
+#define SREC_ERR_TYPE (-5)
+#define SREC_ERR_LINE (-6)
+#define SREC_ERR_READ (-7)
+
+/* One record, the data excludes the address and the checksum */
+typedef struct {
+	int type;
+	unsigned long int address;
+	int len;
+	unsigned char data[256];
+} srec_t;
+
+/* The reader, with its input buffer */
+typedef struct {
+	FILE *fp;
+	unsigned char *buf;
+	size_t len;
+	size_t pos;
+	int eof;
+	int line;
+} srec_reader_t;
+
+/* Open a file for reading, returns 0 on success */
+int srec_open(srec_reader_t *r, const char *name);
+/* Read the next record, returns SREC_OK, SREC_EOF or an error.
+ * On an error, the line is skipped and the next call
+ * continues with the next line */
+int srec_read(srec_reader_t *r, srec_t *rec);
+/* Close the file */
+void srec_close(srec_reader_t *r);
+/* Description of an error */
+const char *srec_strerror(int err);
+
+#endif
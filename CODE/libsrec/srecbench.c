@@ -0,0 +1,216 @@
+/*
+ * srecbench - S-record reader benchmark
+ *
+ * (c)2022, J.E.J. op den Brouw <J.E.J.opdenBrouw@hhs.nl>
+ *
+ * Measures the throughput of the S-record reader. The input
+ * file is read a number of times and the best time is used.
+ * Without an input file, a file with random S3 records is
+ * generated first. For comparison, the file is also read
+ * with fgets and the per-nibble toupper decoding that the
+ * tools used before.
+ *
+ * Options:
+ *      -s <MB>    Size of the generated file, default 16 MB
+ *      -n <runs>  Number of runs, default 3
+ *
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <unistd.h>
+#include <sys/time.h>
+
+#include "srec.h"
+
+/* Current time in seconds */
+double now(void)
+{
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/* Generate a file with S3 records of 32 data bytes */
+int generate(const char *name, long size)
+{
+	FILE *fp = fopen(name, "w");
+	unsigned long int address = 0;
+
+	if (fp == NULL) {
+		return -1;
+	}
+	srand(1);
+	while (ftell(fp) < size) {
+		unsigned int sum = 37 + (address >> 24) + (address >> 16) + (address >> 8) + address;
+		fprintf(fp, "S325%08lX", address);
+		for (int i = 0; i < 32; i++) {
+			unsigned int byte = rand() & 0xff;
+			fprintf(fp, "%02X", byte);
+			sum += byte;
+		}
+		fprintf(fp, "%02X\n", ~sum & 0xff);
+		address += 32;
+	}
+	fclose(fp);
+
+	return 0;
+}
+
+/* Keeps the compiler from optimizing the decoding away */
+volatile unsigned long int sink;
+
+/* The decoding used before, kept for comparison */
+unsigned long int hex2(char buffer[]) {
+	unsigned long int val = 0;
+	unsigned long int efkes = 0;
+
+	buffer[0] = toupper(buffer[0]);
+	buffer[1] = toupper(buffer[1]);
+
+	efkes = (buffer[0] >= 'A') ? 'A' - 10 : '0';
+	val = (unsigned long int)buffer[0] - efkes;
+
+	val = val << 4;
+
+	efkes = (buffer[1] >= 'A') ? 'A' - 10 : '0';
+	val = val + (unsigned long int)buffer[1] - efkes;
+
+	return val;
+}
+
+/* Read the file the old way, returns the number of data bytes */
+long legacy(const char *name)
+{
+	FILE *fp = fopen(name, "r");
+	char buffer[1000];
+	long bytes = 0;
+
+	if (fp == NULL) {
+		return -1;
+	}
+	while (fgets(buffer, sizeof buffer, fp) != NULL) {
+		if (buffer[0] != 'S' || buffer[1] != '3') {
+			continue;
+		}
+		int val = hex2(buffer+2) - 5;
+		sink += (hex2(buffer+4) << 24) + (hex2(buffer+6) << 16) + (hex2(buffer+8) << 8) + hex2(buffer+10);
+		for (int i = 0; i < val; i++) {
+			sink += hex2(buffer+12+i*2);
+		}
+		bytes += val;
+	}
+	fclose(fp);
+
+	return bytes;
+}
+
+/* Read the file with the library, returns the number of data bytes */
+long library(const char *name)
+{
+	srec_reader_t r;
+	srec_t rec;
+	long bytes = 0;
+	int ret;
+
+	if (srec_open(&r, name) < 0) {
+		return -1;
+	}
+	while ((ret = srec_read(&r, &rec)) != SREC_EOF) {
+		if (ret < 0) {
+			fprintf(stderr, "%s in line %d\n", srec_strerror(ret), r.line);
+			continue;
+		}
+		if (rec.type >= 1 && rec.type <= 3) {
+			bytes += rec.len;
+		}
+	}
+	srec_close(&r);
+
+	return bytes;
+}
+
+/* Run a reader a number of times, returns the best time */
+double run(long (*reader)(const char *), const char *name, int runs, long *bytes)
+{
+	double best = 1e9;
+
+	for (int i = 0; i < runs; i++) {
+		double t = now();
+		*bytes = reader(name);
+		t = now() - t;
+		if (t < best) {
+			best = t;
+		}
+	}
+	return best;
+}
+
+int main(int argc, char *argv[])
+{
+	char tmpname[] = "/tmp/srecbenchXXXXXX";
+	const char *name;
+	long size = 16;
+	int runs = 3;
+	int opt;
+	long bytes;
+	double t, tl;
+	FILE *fp;
+
+	while ((opt = getopt(argc, argv, "s:n:")) != -1) {
+		switch (opt) {
+			case 's':
+				size = atol(optarg);
+				break;
+			case 'n':
+				runs = atoi(optarg);
+				break;
+			default:
+				fprintf(stderr, "Usage: srecbench [-s <MB>] [-n <runs>] [inputfile]\n");
+				exit(EXIT_FAILURE);
+		}
+	}
+
+	if (optind < argc) {
+		name = argv[optind];
+	} else {
+		int fd = mkstemp(tmpname);
+		if (fd < 0) {
+			fprintf(stderr, "Cannot create temporary file\n");
+			exit(EXIT_FAILURE);
+		}
+		close(fd);
+		name = tmpname;
+		printf("Generating %ld MB of S-records...\n", size);
+		if (generate(name, size * 1024 * 1024) < 0) {
+			fprintf(stderr, "Cannot write %s\n", name);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	fp = fopen(name, "r");
+	if (fp == NULL) {
+		fprintf(stderr, "Cannot open input file %s\n", name);
+		exit(EXIT_FAILURE);
+	}
+	fseek(fp, 0, SEEK_END);
+	size = ftell(fp);
+	fclose(fp);
+
+	t = run(library, name, runs, &bytes);
+	printf("library: %ld bytes of data in %.3f s, %.1f MB/s of S-records\n",
+	       bytes, t, size / t / 1e6);
+	tl = run(legacy, name, runs, &bytes);
+	printf("legacy:  %ld bytes of data in %.3f s, %.1f MB/s of S-records\n",
+	       bytes, tl, size / tl / 1e6);
+	printf("speedup: %.1f\n", tl / t);
+
+	if (name == tmpname) {
+		unlink(name);
+	}
+
+	return 0;
+}
@@ -0,0 +1,551 @@
+/*
+ * usart.c -- USART driver with transmit and receive ring buffers
+ *
+ * (c)2022, J.E.J. op den Brouw <J.E.J.opdenBrouw@hhs.nl>
+ *
+ * Output is copied to a transmit ring buffer and the function
+ * returns at once. Input is collected in a receive ring buffer.
+ * The buffers are emptied and filled by the USART interrupt, so
+ * the program keeps computing while the output is sent.
+ * The interrupt handler does a bounded amount of work: at most
+ * one byte is read and one byte is written, with the FIFOs at
+ * most a FIFO full each way.
+ *
+ * Compile with -DUSART_POLLED to use no interrupts. Then the
+ * buffers are handled by usart_poll(), which is called by all
+ * usart functions. A program that does not call the usart
+ * functions for a long time must call usart_poll() itself.
+ *
+ * usart_syswrite() and usart_sysread() are used by the _write
+ * and _read system calls, so printf and scanf use the buffers
+ * too. A printf returns as soon as the text is copied.
+ *
+ * In interrupt mode, usart_init() sets mtvec to the handler of
+ * the library (direct mode). Other traps are passed to
+ * usart_trap(), a program may supply its own. A program with
+ * its own trap handler compiles with -DUSART_NO_MTVEC and calls
+ * usart_poll() on a USART interrupt.
+ *
+ * Compile with -DUSART_FIFO for a USART with hardware FIFOs
+ * (design riscv-pipe3-csr-md-lic.bootloader). The handler then
+ * empties the receive FIFO and fills the transmit FIFO, so
+ * there is one interrupt per USART_RXTHRESHOLD received bytes
+ * and one per FIFO of sent bytes.
+ *
+ * The transmit buffer has one writer (the program) and one
+ * reader (the handler), as has the receive buffer. The
+ * indices are only changed by their owners.
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "io.h"
+#include "usart.h"
+
+/* Frequency of the DE0-CV board */
+#ifndef F_CPU
+#define F_CPU (50000000UL)
+#endif
+/* Transmission speed */
+#ifndef BAUD_RATE
+#define BAUD_RATE (9600UL)
+#endif
+
+/* USART status and control bits */
+#define USART_RC (1 << 2)
+#define USART_TC (1 << 4)
+#define USART_TF (1 << 7)
+#define USART_RCIE (1 << 6)
+#define USART_TCIE (1 << 7)
+#define USART_FEN (1 << 8)
+#define USART_RXTIE (1 << 9)
+#define USART_RTIE (1 << 11)
+
+/* Receive FIFO level for an interrupt, at most the FIFO size */
+#ifndef USART_RXTHRESHOLD
+#define USART_RXTHRESHOLD (8)
+#endif
+
+/* Transmit ring buffer and a buffer sent without copying */
+static volatile unsigned char txring[USART_TXLEN];
+static volatile unsigned long txhead, txtail;
+static const unsigned char * volatile txbuf;
+static volatile int txlen;
+/* A byte is in the transmitter */
+static volatile int txbusy;
+
+/* Receive ring buffer */
+static volatile unsigned char rxring[USART_RXLEN];
+static volatile unsigned long rxhead, rxtail, rxoverruns;
+
+/* Mode of the system calls */
+static int sysmode = USART_BLOCKING;
+
+/* Next byte to send from the ring or the send buffer,
+ * -1 if there is none */
+static int txnext(void)
+{
+	int c;
+
+	if (txtail != txhead) {
+		c = txring[txtail];
+		txtail = (txtail + 1) & (USART_TXLEN - 1);
+	} else if (txlen > 0) {
+		c = *txbuf++;
+		txlen--;
+	} else {
+		c = -1;
+	}
+	return c;
+}
+
+/* Write the next byte to the USART, with the FIFO until it is
+ * full. Returns the number of bytes written */
+static int txfill(void)
+{
+	int c;
+	int n = 0;
+
+	while ((c = txnext()) >= 0) {
+		/* Writing the data clears the flag */
+		USART->DATA = c;
+		n++;
+#ifdef USART_FIFO
+		if (USART->STAT & USART_TF) {
+			break;
+		}
+#else
+		break;
+#endif
+	}
+	return n;
+}
+
+/* Bounded handling of the USART, at most one byte in and
+ * one byte out, with the FIFOs at most a FIFO full each way */
+void usart_poll(void)
+{
+	unsigned long stat = USART->STAT;
+	unsigned long next;
+	int c;
+
+	while (stat & USART_RC) {
+		/* Reading the data clears the flag */
+		c = USART->DATA & 0xff;
+		next = (rxhead + 1) & (USART_RXLEN - 1);
+		if (next == rxtail) {
+			rxoverruns++;
+		} else {
+			rxring[rxhead] = c;
+			rxhead = next;
+		}
+#ifdef USART_FIFO
+		stat = USART->STAT;
+#else
+		break;
+#endif
+	}
+
+	/* With the FIFO, TC is set when the FIFO is empty */
+	if (txbusy && (stat & USART_TC)) {
+		if (txfill() == 0) {
+			txbusy = 0;
+#ifndef USART_POLLED
+			USART->CTRL &= ~USART_TCIE;
+#endif
+		}
+	}
+}
+
+#ifndef USART_POLLED
+#ifndef USART_NO_MTVEC
+/* Called for every trap other than the USART interrupt. The
+ * default does nothing: the processor returns after an ECALL
+ * or EBREAK, other interrupts are ignored. A program with other
+ * interrupts or exceptions supplies its own */
+__attribute__((weak))
+void usart_trap(unsigned long mcause)
+{
+}
+
+/* The trap handler, handles the USART interrupt and passes
+ * other traps on to usart_trap() */
+__attribute__((interrupt))
+static void usart_handler(void)
+{
+	unsigned long mcause;
+
+	__asm__ volatile ("csrr %0, mcause" : "=r" (mcause));
+	if (mcause == USART_IN_MCAUSE) {
+		usart_poll();
+	} else {
+		usart_trap(mcause);
+	}
+}
+#endif
+
+/* Disable interrupts, returns the old mstatus */
+static inline unsigned long irq_save(void)
+{
+	unsigned long mstatus;
+
+	__asm__ volatile ("csrrci %0, mstatus, 8" : "=r" (mstatus) :: "memory");
+	return mstatus;
+}
+
+/* Enable interrupts if they were enabled */
+static inline void irq_restore(unsigned long mstatus)
+{
+	__asm__ volatile ("csrs mstatus, %0" : : "r" (mstatus & 8) : "memory");
+}
+#endif
+
+/* Called in the wait loops. With interrupts off, in a trap
+ * handler or in polled mode, the USART is polled */
+static void idle(void)
+{
+#ifndef USART_POLLED
+	unsigned long mstatus;
+
+	__asm__ volatile ("csrr %0, mstatus" : "=r" (mstatus));
+	if (mstatus & 8) {
+		return;
+	}
+#endif
+	usart_poll();
+}
+
+/* Start the transmitter if it is idle. In interrupt mode the
+ * transmit complete interrupt sends the rest */
+static void txstart(void)
+{
+#ifndef USART_POLLED
+	unsigned long mstatus = irq_save();
+#endif
+
+	if (!txbusy && txfill() > 0) {
+		txbusy = 1;
+#ifndef USART_POLLED
+		USART->CTRL |= USART_TCIE;
+#endif
+	}
+#ifndef USART_POLLED
+	irq_restore(mstatus);
+#else
+	usart_poll();
+#endif
+}
+
+/* Initialize the Baud Rate Generator and the buffers */
+void usart_init(void)
+{
+	/* Set baud rate generator */
+	USART->BAUD = F_CPU/BAUD_RATE-1;
+
+	txhead = txtail = 0;
+	txlen = 0;
+	txbusy = 0;
+	rxhead = rxtail = rxoverruns = 0;
+#ifdef USART_POLLED
+	/* 8N1, no interrupts */
+#ifdef USART_FIFO
+	USART->CTRL = USART_FEN;
+#else
+	USART->CTRL = 0x00;
+#endif
+#else
+#ifndef USART_NO_MTVEC
+	/* Set the handler, direct mode */
+	__asm__ volatile ("csrw mtvec, %0" : : "r" (usart_handler));
+#endif
+#ifdef USART_FIFO
+	/* 8N1, FIFOs, interrupt on the receive threshold or when
+	 * bytes are left in the FIFO */
+	USART->CTRL = USART_FEN | USART_RXTIE | USART_RTIE | (USART_RXTHRESHOLD << 16);
+#else
+	/* 8N1, receive interrupt enable */
+	USART->CTRL = USART_RCIE;
+#endif
+	/* Set mstatus.MIE, the LIC interrupts need no mie bit */
+	__asm__ volatile ("csrsi mstatus, 8");
+#endif
+}
+
+/* Stop the USART, the program continues with the USART
+ * as after reset */
+void usart_stop(void)
+{
+	USART->CTRL = 0;
+	USART->BAUD = 0;
+	txhead = txtail = 0;
+	txlen = 0;
+	txbusy = 0;
+}
+
+int usart_txfree(void)
+{
+	return (txtail - txhead - 1) & (USART_TXLEN - 1);
+}
+
+int usart_write(const void *buf, int len)
+{
+	const unsigned char *p = buf;
+	unsigned long head = txhead;
+	int n = 0;
+
+	/* Keep the order of the output: nothing is added while
+	 * a buffer is sent without copying */
+	if (txlen == 0) {
+		while (n < len && ((head + 1) & (USART_TXLEN - 1)) != txtail) {
+			txring[head] = p[n++];
+			head = (head + 1) & (USART_TXLEN - 1);
+		}
+		txhead = head;
+	}
+	txstart();
+
+	return n;
+}
+
+int usart_send(const void *buf, int len)
+{
+	if (txlen > 0 || txhead != txtail) {
+		idle();
+		return -1;
+	}
+	if (len > 0) {
+		txbuf = buf;
+		txlen = len;
+		txstart();
+	}
+	return 0;
+}
+
+int usart_busy(void)
+{
+#ifdef USART_POLLED
+	usart_poll();
+#endif
+	return txbusy;
+}
+
+int usart_flush(unsigned long timeout)
+{
+	unsigned long start = TIME;
+
+	while (txbusy) {
+		idle();
+		if (timeout > 0 && TIME - start > timeout) {
+			return -1;
+		}
+	}
+	return 0;
+}
+
+int usart_received(void)
+{
+#ifdef USART_POLLED
+	usart_poll();
+#endif
+	return (rxhead - rxtail) & (USART_RXLEN - 1);
+}
+
+unsigned long usart_overruns(void)
+{
+	unsigned long n = rxoverruns;
+
+	rxoverruns = 0;
+	return n;
+}
+
+int usart_read(void *buf, int len)
+{
+	unsigned char *p = buf;
+	unsigned long tail = rxtail;
+	int n = 0;
+
+#ifdef USART_POLLED
+	usart_poll();
+#endif
+	while (n < len && tail != rxhead) {
+		p[n++] = rxring[tail];
+		tail = (tail + 1) & (USART_RXLEN - 1);
+	}
+	rxtail = tail;
+
+	return n;
+}
+
+/* Send one character over the USART, waits while the
+ * buffer is full */
+void usart_putc(int ch)
+{
+	unsigned char c = ch;
+
+	while (usart_write(&c, 1) == 0) {
+		idle();
+	}
+}
+
+/* Send a null-terminated string over the USART */
+void usart_puts(const char *s)
+{
+	if (s == NULL)
+	{
+		return;
+	}
+
+	while (*s != '\0')
+	{
+		usart_putc(*s++);
+	}
+}
+
+/* Get one character from the USART in
+ * blocking mode */
+int usart_getc(void)
+{
+	unsigned char c;
+
+	/* Wait for received character */
+	while (usart_read(&c, 1) == 0) {
+		idle();
+	}
+
+	return c;
+}
+
+/* Get one character from the USART, wait at most
+ * timeout micro seconds. Returns -1 on timeout */
+int usart_getc_timeout(unsigned long timeout)
+{
+	unsigned long start = TIME;
+	unsigned char c;
+
+	/* Wait for received character or timeout */
+	while (usart_read(&c, 1) == 0) {
+		idle();
+		if (TIME - start > timeout) {
+			return -1;
+		}
+	}
+
+	return c;
+}
+
+void usart_setmode(int mode)
+{
+	sysmode = mode;
+}
+
+int usart_syswrite(const void *buf, int len)
+{
+	const unsigned char *p = buf;
+	int n;
+
+	if (sysmode == USART_NONBLOCKING) {
+		n = usart_write(p, len);
+		return (n == 0 && len > 0) ? -1 : n;
+	}
+
+	/* Only wait if the buffer is full */
+	n = usart_write(p, len);
+	while (n < len) {
+		idle();
+		n += usart_write(p + n, len - n);
+	}
+	if (sysmode == USART_LINEBUFFERED && memchr(p, '\n', len) != NULL) {
+		usart_flush(0);
+	}
+
+	return n;
+}
+
+int usart_sysread(void *buf, int len)
+{
+	unsigned char *p = buf;
+	int n = 0;
+
+	if (len <= 0) {
+		return 0;
+	}
+	if (sysmode == USART_NONBLOCKING) {
+		n = usart_read(p, len);
+		return (n == 0) ? -1 : n;
+	}
+	if (sysmode == USART_BLOCKING) {
+		while ((n = usart_read(p, len)) == 0) {
+			idle();
+		}
+		return n;
+	}
+
+	/* Line buffered, up to and including the line end.
+	 * Terminals send a CR, the C library wants a LF */
+	while (n < len) {
+		p[n] = usart_getc();
+		if (p[n] == '\r') {
+			p[n] = '\n';
+		}
+		if (p[n++] == '\n') {
+			break;
+		}
+	}
+
+	return n;
+}
+
+/* Gets a string terminated by a newline character from usart
+ * The newline character is not part of the returned string.
+ * The string is null-terminated.
+ * A maximum of size-1 characters are read.
+ * Some simple line handling is implemented */
+int usart_gets(char buffer[], int size)
+{
+	int index = 0;
+	char chr;
+
+	while (1) {
+		chr = usart_getc();
+		switch (chr) {
+			case '\n':
+			case '\r':	buffer[index] = '\0';
+					usart_puts("\r\n");
+					return index;
+					break;
+			/* Backspace key */
+			case 0x7f:
+			case '\b':	if (index>0) {
+						usart_putc(0x7f);
+						index--;
+					} else {
+						usart_putc('\a');
+					}
+					break;
+			/* control-U */
+			case 21:	while (index>0) {
+						usart_putc(0x7f);
+						index--;
+					}
+					break;
+			/* control-C */
+			case 0x03:  	usart_puts("<break>\r\n");
+					index=0;
+					break;
+			default:	if (index<size-1) {
+						if (chr>0x1f && chr<0x7f) {
+							buffer[index] = chr;
+							index++;
+							usart_putc(chr);
+						}
+					} else {
+						usart_putc('\a');
+					}
+					break;
+		}
+	}
+	return index;
+}
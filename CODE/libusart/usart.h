@@ -0,0 +1,92 @@
+/*
+ * usart.h -- USART driver with transmit and receive ring buffers
+ *
+ * (c)2022, J.E.J. op den Brouw <J.E.J.opdenBrouw@hhs.nl>
+ *
+ */
+
+#ifndef _USART_H
+#define _USART_H
+
+/* Size of the transmit and receive ring buffers, must be a
+ * power of 2 */
+#ifndef USART_TXLEN
+#define USART_TXLEN (256)
+#endif
+#ifndef USART_RXLEN
+#define USART_RXLEN (128)
+#endif
+
+/* The USART interrupt is LIC interrupt 18 */
+#define USART_IN_MCAUSE ((1UL<<31)+18)
+
+/* Initialize the USART. In interrupt mode, the receive
+ * interrupt is started and interrupts are enabled */
+void usart_init(void);
+/* Stop the USART and its interrupts, pending output is lost */
+void usart_stop(void);
+
+/* Copy at most len bytes to the transmit buffer, returns the
+ * number of bytes copied. Never waits */
+int usart_write(const void *buf, int len);
+/* Send len bytes straight from buf, without copying. Returns
+ * 0 if started, -1 if the transmitter is busy. The buffer
+ * must not change until usart_busy() returns 0 */
+int usart_send(const void *buf, int len);
+/* Copy at most len received bytes to buf, returns the number
+ * of bytes copied. Never waits */
+int usart_read(void *buf, int len);
+/* Wait until all output is sent, at most timeout micro
+ * seconds, 0 waits forever. Returns 0 or -1 on timeout */
+int usart_flush(unsigned long timeout);
+/* Non-zero if output is still being sent */
+int usart_busy(void);
+/* Free space in the transmit buffer */
+int usart_txfree(void);
+/* Number of bytes in the receive buffer */
+int usart_received(void);
+/* Number of bytes lost because the receive buffer was full,
+ * cleared after reading */
+unsigned long usart_overruns(void);
+
+/* Write one character to USART, waits if the buffer is full */
+void usart_putc(int ch);
+/* Write null-terminated string to USART */
+void usart_puts(const char *s);
+/* Get one character from USART */
+int usart_getc(void);
+/* Get one character from USART with timeout in us, -1 on timeout */
+int usart_getc_timeout(unsigned long timeout);
+/* Get maximum size-1 characters in string buffer from USART */
+int usart_gets(char buffer[], int size);
+
+/* Modes of the _write and _read system calls */
+#define USART_BLOCKING (0)
+#define USART_NONBLOCKING (1)
+#define USART_LINEBUFFERED (2)
+
+/* Set the mode of usart_syswrite and usart_sysread */
+void usart_setmode(int mode);
+/* Write for the _write system call. Blocking: copies all,
+ * waits while the buffer is full. Non-blocking: copies what
+ * fits, -1 if nothing fits. Line buffered: as blocking and
+ * waits until the output is sent if it holds a newline */
+int usart_syswrite(const void *buf, int len);
+/* Read for the _read system call. Blocking: waits for at
+ * least one byte. Non-blocking: -1 if nothing is received.
+ * Line buffered: waits for a line end (CR becomes LF) or
+ * len bytes */
+int usart_sysread(void *buf, int len);
+
+/* Called by the trap handler of the library for all traps
+ * other than the USART interrupt, with the mcause. The default
+ * does nothing, a program may supply its own */
+void usart_trap(unsigned long mcause);
+
+/* Move bytes between the USART and the buffers. In polled
+ * mode, call this often, all usart functions call it too.
+ * In interrupt mode with USART_NO_MTVEC, call it from the
+ * trap handler on a USART interrupt */
+void usart_poll(void);
+
+#endif
@@ -1,95 +1,80 @@
-/* 
+/*
  * srec2mif - Motorola S-record to MIF converter
  *
  * (c)2021, J.E.J. op den Brouw <J.E.J.opdenBrouw@hhs.nl>
  *
  * This program converts a file with Motorola S-records to
- * a series of Memory Initialization File (mif) statements
+ * a Memory Initialization File (mif) for Quartus
  *
  * Recognized S-records: S0, S1, S2, S3, S7, S8, S9.
  * S4, S5 and S6 are skipped.
- * The checksum is not checked.
+ * The count and the checksum are checked.
  *
- * By default, srec2vhdl creates only the table entries
+ * The memory is 2^bits bytes, as set with rom_size_bits or
+ * bootloader_size_bits in processor_common.vhd. The memory
+ * decodes the lower bits of the address, so the window of
+ * the memory is taken from the first data record. Data
+ * outside this window is skipped. Runs of equal elements
+ * are output as an address range.
  *
  * Options:
  *      -v         Verbose output
  *      -q         Quiet output, only errors are reported
+ *      -b         Output as bytes (default)
+ *      -w         Output as words (32 bits, as in rom.vhd)
+ *      -s <bits>  Size of the memory as 2^bits bytes
  *
  * */
 
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
-#include <ctype.h>
 #include <unistd.h>
 
-/* 1000 should be enough */
-#define LENGTH 1000
+#include "srec.h"
 
-/* Convert 2 ASCII characters to 1 byte */
-unsigned long int hex2(char buffer[]) {
-	unsigned long int val = 0;
-	unsigned long int efkes = 0;
+#define BYTE (1)
+#define WORD (4)
 
-	buffer[0] = toupper(buffer[0]);
-	buffer[1] = toupper(buffer[1]);
+/* Default is a 64 kB ROM */
+#define SIZE_BITS (16)
 
-	efkes = (buffer[0] >= 'A') ? 'A' - 10 : '0';
-	val = (unsigned long int)buffer[0] - efkes;
+/* Output an element or a range of equal elements */
+void putelement(FILE *fout, unsigned long int first, unsigned long int last,
+		unsigned char code[], int size) {
 
-	val = val << 4;
-
-	efkes = (buffer[1] >= 'A') ? 'A' - 10 : '0';
-	val = val + (unsigned long int)buffer[1] - efkes;
-
-	return val;
-}
-
-/* Convert 4 ASCII characters to 2 bytes */
-unsigned long int hex4(char buffer[]) {
-
-	unsigned long int val = 0;
-
-	val = (hex2(buffer) << 8) + hex2(buffer+2);
-
-	return val;
-}
-
-/* Convert 6 ASCII characters to 3 bytes */
-unsigned long int hex6(char buffer[]) {
-
-	unsigned long int val = 0;
-
-	val = (hex2(buffer) << 16) + (hex2(buffer+2) << 8) + hex2(buffer+4);
-
-	return val;
-}
-
-/* Convert 8 ASCII characters to 4 bytes */
-unsigned long int hex8(char buffer[]) {
-
-	unsigned long int val = 0;
-
-	val = (hex2(buffer) << 24) + (hex2(buffer+2) << 16) + (hex2(buffer+4) << 8) + hex2(buffer+6);
-
-	return val;
+	if (first == last) {
+		fprintf(fout, "%4lx : ", first);
+	} else {
+		fprintf(fout, "[%lx..%lx] : ", first, last);
+	}
+	for (int i = 0; i < size; i++) {
+		fprintf(fout, "%02x", code[i]);
+	}
+	fprintf(fout, ";\n");
 }
 
 /* main */
 int main(int argc, char *argv[]) {
 
-	FILE *fp, *fout;
-	char buffer[LENGTH];
-	int line = 0;
-	unsigned long int val;
-	unsigned long int address;
-	unsigned long int byte;
+	FILE *fout;
+	srec_reader_t r;
+	srec_t rec;
+	int ret;
 	int i;
+	/* The memory image and a flag per byte if present */
+	unsigned char *data, *used;
+	unsigned long int memsize, base = 0, skipped = 0;
+	int havebase = 0;
+	/* Current run of equal elements */
+	unsigned char code[WORD], runcode[WORD];
+	unsigned long int first = 0, nrun = 0, depth;
 
 	/* Options */
 	int opt;
 	int verbose, full;
+	int size = BYTE;
+	int bits = SIZE_BITS;
 
 	/* Set defaults on options */
 	full = 1;
@@ -98,15 +83,18 @@ int main(int argc, char *argv[]) {
 	/* Check for 0 extra arguments */
 	if (argc == 1) {
 		printf("srec2mif -- an S-record to MIF table converter\n");
-		printf("Usage: srecmif [-vq] inputfile [outputfile]\n");
+		printf("Usage: srec2mif [-vqbw -s <bits>] inputfile [outputfile]\n");
 		printf("   -v        Verbose\n");
 		printf("   -q        Quiet. Only errors are reported\n");
+		printf("   -b        Byte output (default)\n");
+		printf("   -w        Word output (32 bits, as in rom.vhd)\n");
+		printf("   -s <bits> Memory size is 2^bits bytes (default %d)\n", SIZE_BITS);
 		printf("If outputfile is omitted, stdout is used\n");
 		exit(EXIT_SUCCESS);
 	}
 
 	/* Parse options */
-	while ((opt = getopt(argc, argv, "vqfi:")) != -1) {
+	while ((opt = getopt(argc, argv, "vqbws:")) != -1) {
 	        switch (opt) {
 	        case 'v':
 	            verbose = 1;
@@ -114,6 +102,19 @@ int main(int argc, char *argv[]) {
 	        case 'q':
 	            verbose = 0;
 	            break;
+	        case 'b':
+	            size = BYTE;
+	            break;
+	        case 'w':
+	            size = WORD;
+	            break;
+	        case 's':
+	            bits = atoi(optarg);
+	            if (bits < 2 || bits > 28) {
+	                fprintf(stderr, "Size must be 2 to 28 bits\n");
+	                exit(EXIT_FAILURE);
+	            }
+	            break;
 	        default: /* '?' */
 		    fprintf(stderr, "Unknown option '%c'\n", opt);
 	            exit(EXIT_FAILURE);
@@ -129,124 +130,138 @@ int main(int argc, char *argv[]) {
 	    exit(EXIT_FAILURE);
 	}
 
-	fp = fopen(argv[optind], "r");
-	if (fp == NULL) {
-		fprintf(stderr, "Cannot open input file %s\n", argv[1]);
+	memsize = 1UL << bits;
+	depth = memsize / size;
+	data = calloc(memsize, 1);
+	used = calloc(memsize, 1);
+	if (data == NULL || used == NULL) {
+		fprintf(stderr, "Out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (srec_open(&r, argv[optind]) < 0) {
+		fprintf(stderr, "Cannot open input file %s\n", argv[optind]);
 		exit (EXIT_FAILURE);
 	}
 
 
 	if (argv[optind+1] == NULL) {
 		if (verbose) {
-			printf("Using stdout\n");
+			fprintf(stderr, "Using stdout\n");
 		}
 		fout = stdout;
 	} else {
 		if (strcmp(argv[optind], argv[optind+1]) == 0) {
 			fprintf(stderr, "Input filename and output filename cannot be the same\n");
-			fclose(fp);
+			srec_close(&r);
 			exit(EXIT_FAILURE);
 		}
 		fout = fopen(argv[optind+1], "w");
 		if (fout == NULL) {
-			fclose(fp);
+			srec_close(&r);
 			fprintf(stderr, "Cannot open output file %s\n", argv[optind+1]);
 			exit(EXIT_FAILURE);
 		}
 	}
 
-	if (full) {
-		fprintf(fout, "WIDTH=8;\n");
-		fprintf(fout, "DEPTH=16384;\n");
-		fprintf(fout, "ADDRESS_RADIX=HEX;\n");
-		fprintf(fout, "DATA_RADIX=HEX;\n\n");
-		fprintf(fout, "CONTENT BEGIN\n\n");
-	}
-
-	while (fgets(buffer, LENGTH, fp) != NULL) {
-		line++;
-		if (buffer[0] != 'S') {
-			fprintf(stderr, "Not an S-record in line %d!\n", line);
+	while ((ret = srec_read(&r, &rec)) != SREC_EOF) {
+		if (ret == SREC_ERR_NOTSREC) {
+			fprintf(stderr, "Not an S-record in line %d!\n", r.line);
 			continue;
 		}
-		val = 0;
-		switch (buffer[1]) {
-			case '0': val = hex2(buffer+2);
-				  val = val - 3;
-				  if (verbose) {
-				  	fprintf(stderr, "Vendor text: ");
-				  	for (i = 0; i < val; i++) {
-						char c = (char) hex2(buffer+8+i*2);
-						fprintf(stderr, "%c", c);
-					}
-				  	fprintf(stderr, "\n");
-				  }
-				  break;
-			case '1': val = hex2(buffer+2);
-				  val = val-3;
-				  address = hex4(buffer+4);
-				  for (i = 0; i < val; i++) {
-					byte = hex2(buffer+8+i*2);
-					fprintf(fout, "%4lx : %02lx;\n", address, byte);
-					address++;
+		if (ret < 0) {
+			fprintf(stderr, "%s in line %d!\n", srec_strerror(ret), r.line);
+			srec_close(&r);
+			fclose(fout);
+			exit(EXIT_FAILURE);
+		}
+		switch (rec.type) {
+			case 0:   if (verbose) {
+				  	fprintf(stderr, "Vendor text: %.*s\n", rec.len, (char *) rec.data);
 				  }
 				  break;
-			case '2': val = hex2(buffer+2);
-				  val = val-4;
-				  address = hex6(buffer+4);
-				  for (i = 0; i < val; i++) {
-					byte = hex2(buffer+10+i*2);
-					fprintf(fout, "%4lx => %02lx;\n", address, byte);
-					address++;
+			case 1:
+			case 2:
+			case 3:   if (!havebase && rec.len > 0) {
+					base = rec.address & ~(memsize-1);
+					havebase = 1;
 				  }
-				  break;
-			case '3': val = hex2(buffer+2);
-				  val = val-5;
-				  address = hex8(buffer+4);
-				  for (i = 0; i < val; i++) {
-					byte = hex2(buffer+12+i*2);
-					fprintf(fout, "%4lx => %02lx;\n", address, byte);
-					address++;
+				  for (i = 0; i < rec.len; i++) {
+					unsigned long int address = rec.address + i;
+					if ((address & ~(memsize-1)) != base) {
+						skipped++;
+						continue;
+					}
+					data[address - base] = rec.data[i];
+					used[address - base] = 1;
 				  }
 				  break;
-			case '4': if (verbose) {
+			case 4:   if (verbose) {
 					  fprintf(stderr, "Reserved S-record\n");
 				  }
 				  break;
-			case '5': if (verbose) {
+			case 5:
+			case 6:   if (verbose) {
 					  fprintf(stderr, "Optional count record skipped\n");
 				  }
 				  break;
-			case '6': if (verbose) {
-					  fprintf(stderr, "Optional count record skipped\n");
-				  }
-				  break;
-			case '7': if (verbose) {
+			default:  if (verbose) {
 					  fprintf(stderr, "Termination record\n");
 				  }
 				  break;
-			case '8': if (verbose) {
-					  fprintf(stderr, "Termination record\n");
-				  }
-				  break;
-			case '9': if (verbose) {
-					  fprintf(stderr, "Termination record\n");
-				  }
-				  break;
-			default : if (verbose) {
-					  fprintf(stderr, "Invalid S-record in line %d\n", line);
-				  }
-				  break;
 		}
+	}
 
+	if (skipped > 0) {
+		fprintf(stderr, "Skipped %lu bytes outside 0x%08lx-0x%08lx\n",
+			skipped, base, base + memsize - 1);
+	}
+	if (verbose) {
+		fprintf(stderr, "Memory of %lu elements of %d bits at 0x%08lx\n",
+			depth, size*8, base);
+	}
+
+	if (full) {
+		fprintf(fout, "WIDTH=%d;\n", size*8);
+		fprintf(fout, "DEPTH=%lu;\n", depth);
+		fprintf(fout, "ADDRESS_RADIX=HEX;\n");
+		fprintf(fout, "DATA_RADIX=HEX;\n\n");
+		fprintf(fout, "CONTENT BEGIN\n\n");
+	}
+
+	/* Elements without data are zero, as in the VHDL tables */
+	for (unsigned long int index = 0; index < depth; index++) {
+		int present = 0;
+
+		for (i = 0; i < size; i++) {
+			code[i] = data[index*size+i];
+			present |= used[index*size+i];
+		}
+		if (!present) {
+			memset(code, 0, size);
+		}
+		/* Extend the current run or start a new one */
+		if (nrun > 0 && memcmp(code, runcode, size) == 0) {
+			nrun++;
+			continue;
+		}
+		if (nrun > 0) {
+			putelement(fout, first, first + nrun - 1, runcode, size);
+		}
+		memcpy(runcode, code, size);
+		first = index;
+		nrun = 1;
 	}
+	putelement(fout, first, first + nrun - 1, runcode, size);
 
 	if (full) {
 		fprintf(fout, "\nEND;\n");
 	}
 
-	fclose(fp);
+	srec_close(&r);
 	fclose(fout);
+	free(data);
+	free(used);
 
 	return 0;
 }
@@ -8,7 +8,7 @@
  *
  * Recognized S-records: S0, S1, S2, S3, S7, S8, S9.
  * S4, S5 and S6 are skipped.
- * The checksum is not checked.
+ * The count and the checksum are checked.
  *
  * By default, srec2vhdl creates only the table entries
  *
@@ -20,95 +20,401 @@
  *      -b         Output as bytes
  *      -h         Output as half words (16 bits, Little Endian)
  *      -w         Output as words (32 bits, Little Endian)
+ *      -r <s>:<l> Only output the l bytes from address s
+ *      -c         Compact output: runs of equal elements are
+ *                 output as range choices and with -f -0 zero
+ *                 elements are left to the others clause
+ *      -t         Output a data file with an index and a hex
+ *                 value per line, read by rom.vhd with textio
+ *      -m <file>  Also write a MIF file
+ *      -B <file>  Also write a flat binary file
+ *      -x <file>  Also write an Intel HEX file
+ *      -C <file>  Also write a C header with an array
+ *      -S         Print the size of each region
  *
- * The address of the first record is used as an offset
- * so that the first records starts at vector element 0.
+ * The S-records are read once, all outputs are written from
+ * the same memory image. The MIF, binary and C outputs cover
+ * the range or else the region at the offset.
+ *
+ * The lowest address (or the start of the range) is used as
+ * an offset so that it starts at vector element 0.
+ *
+ * The data is kept in pages of 4 KB that are allocated when
+ * data is present, so several regions anywhere in the 4 GB
+ * address space can be converted with little memory. Words
+ * without data are not output, the others clause covers them.
  *
  * */
 
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
-#include <ctype.h>
 #include <unistd.h>
+#include <ctype.h>
 
-#define VERSION "v0.2"
+#include "srec.h"
 
-/* 1000 should be enough */
-#define LEN_BUFFER (1000)
+#define VERSION "v0.5"
 
-/* This should really be enough */
-#define LEN_CODE (10000000)
+/* Page size and number of hash chains of the memory image */
+#define PAGE_BITS (12)
+#define PAGE_SIZE (1UL << PAGE_BITS)
+#define HASH_SIZE (1024)
 
 #define BYTE (1)
 #define HALFWORD (2)
 #define WORD (4)
 
-/* Make next global, otherwise it can be on the stack */
-unsigned char code[LEN_CODE] = { 0 };
+/* A page of the memory image, with a bit per byte that
+ * is set if the byte is present in the input */
+typedef struct page {
+	unsigned long int addr;
+	struct page *next;
+	unsigned char data[PAGE_SIZE];
+	unsigned char used[PAGE_SIZE/8];
+} page_t;
+
+/* The memory image, pages are found by a hash on the page
+ * number and are kept in a list for output */
+page_t *hash[HASH_SIZE];
+page_t **pages;
+int npages;
+unsigned long int nbytes;
+
+/* Find the page of an address, create it if needed */
+page_t *getpage(unsigned long int address, int create) {
+	static page_t *last = NULL;
+	unsigned long int addr = address & ~(PAGE_SIZE-1);
+	page_t **chain = &hash[(addr >> PAGE_BITS) % HASH_SIZE];
+	page_t *p;
+
+	/* Most accesses hit the same page as the previous one */
+	if (last != NULL && last->addr == addr) {
+		return last;
+	}
 
-/* Convert 2 ASCII characters to 1 byte */
-unsigned long int hex2(char buffer[]) {
-	unsigned long int val = 0;
-	unsigned long int efkes = 0;
+	for (p = *chain; p != NULL; p = p->next) {
+		if (p->addr == addr) {
+			return last = p;
+		}
+	}
+	if (!create) {
+		return NULL;
+	}
 
-	buffer[0] = toupper(buffer[0]);
-	buffer[1] = toupper(buffer[1]);
+	p = calloc(1, sizeof(page_t));
+	if (p == NULL || (npages % 64 == 0 &&
+	    (pages = realloc(pages, (npages + 64) * sizeof(page_t *))) == NULL)) {
+		fprintf(stderr, "Out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+	p->addr = addr;
+	p->next = *chain;
+	*chain = p;
+	pages[npages++] = p;
 
-	efkes = (buffer[0] >= 'A') ? 'A' - 10 : '0';
-	val = (unsigned long int)buffer[0] - efkes;
+	return last = p;
+}
+
+/* Store a byte in the memory image */
+void putbyte(unsigned long int address, unsigned long int byte) {
+	page_t *p = getpage(address, 1);
+	unsigned long int i = address & (PAGE_SIZE-1);
 
-	val = val << 4;
+	if (!(p->used[i/8] & (1 << (i%8)))) {
+		nbytes++;
+	}
+	p->data[i] = byte;
+	p->used[i/8] |= 1 << (i%8);
+}
 
-	efkes = (buffer[1] >= 'A') ? 'A' - 10 : '0';
-	val = val + (unsigned long int)buffer[1] - efkes;
+/* Get a byte from the memory image, returns 1 if present */
+int getbyte(unsigned long int address, unsigned char *byte) {
+	page_t *p = getpage(address, 0);
+	unsigned long int i = address & (PAGE_SIZE-1);
 
-	return val;
+	if (p == NULL || !(p->used[i/8] & (1 << (i%8)))) {
+		*byte = 0;
+		return 0;
+	}
+	*byte = p->data[i];
+	return 1;
 }
 
-/* Convert 4 ASCII characters to 2 bytes */
-unsigned long int hex4(char buffer[]) {
+/* Sort pages on address */
+int pagecmp(const void *a, const void *b) {
+	unsigned long int x = (*(page_t **) a)->addr;
+	unsigned long int y = (*(page_t **) b)->addr;
+
+	return (x > y) - (x < y);
+}
 
-	unsigned long int val = 0;
+/* Output one element or a range of equal elements. In a
+ * data file, every element of a range is written on its own
+ * line as index and value. */
+void putelement(FILE *fout, unsigned long int first, unsigned long int last,
+		unsigned char code[], int size, int indentarg, int datafile) {
+	char value[2*WORD+1];
 
-	val = (hex2(buffer) << 8) + hex2(buffer+2);
+	for (int i = 0; i < size; i++) {
+		sprintf(value+2*i, "%02x", code[i]);
+	}
 
-	return val;
+	if (datafile) {
+		for (; first <= last; first++) {
+			fprintf(fout, "%lu %s\n", first, value);
+		}
+		return;
+	}
+
+	fprintf(fout, "%*s", indentarg, "");
+	if (first == last) {
+		fprintf(fout, "%4lu => x\"%s\",\n", first, value);
+	} else {
+		fprintf(fout, "%4lu to %4lu => x\"%s\",\n", first, last, value);
+	}
 }
 
-/* Convert 6 ASCII characters to 3 bytes */
-unsigned long int hex6(char buffer[]) {
+/* Get an element from the memory image, returns 1 if
+ * any byte of it is present */
+int getelement(unsigned long int address, unsigned char code[], int size) {
+	int present = 0;
 
-	unsigned long int val = 0;
+	for (int i = 0; i < size; i++) {
+		present |= getbyte(address+i, &code[i]);
+	}
+	return present;
+}
 
-	val = (hex2(buffer) << 16) + (hex2(buffer+2) << 8) + hex2(buffer+4);
+/* Find the present bytes of a page, returns the number */
+int pageused(page_t *p, unsigned long int *lo, unsigned long int *hi) {
+	int n = 0;
 
-	return val;
+	for (unsigned long int i = 0; i < PAGE_SIZE; i++) {
+		if (p->used[i/8] & (1 << (i%8))) {
+			if (n++ == 0) {
+				*lo = p->addr + i;
+			}
+			*hi = p->addr + i + 1;
+		}
+	}
+	return n;
 }
 
-/* Convert 8 ASCII characters to 4 bytes */
-unsigned long int hex8(char buffer[]) {
+/* End of the region with the address, regions are runs of
+ * consecutive pages. Pages must be sorted. */
+unsigned long int regionend(unsigned long int address) {
+	unsigned long int lo, hi = address;
+	int n;
+
+	for (n = 0; n < npages && pages[n]->addr + PAGE_SIZE <= address; n++);
+	for (; n < npages; n++) {
+		pageused(pages[n], &lo, &hi);
+		if (n + 1 < npages && pages[n]->addr + PAGE_SIZE != pages[n+1]->addr) {
+			break;
+		}
+	}
+	return hi;
+}
 
-	unsigned long int val = 0;
+/* Print the start, end and number of bytes of each region */
+void report(FILE *fp) {
+	unsigned long int lo = 0, hi = 0, rlo = 0, rhi = 0, rbytes = 0;
+	int region = 0;
 
-	val = (hex2(buffer) << 24) + (hex2(buffer+2) << 16) + (hex2(buffer+4) << 8) + hex2(buffer+6);
+	fprintf(fp, "Region  Start       End         Bytes\n");
+	for (int n = 0; n < npages; n++) {
+		int used = pageused(pages[n], &lo, &hi);
 
-	return val;
+		if (n > 0 && pages[n-1]->addr + PAGE_SIZE != pages[n]->addr) {
+			fprintf(fp, "%6d  0x%08lx  0x%08lx  %lu\n", region++, rlo, rhi - 1, rbytes);
+			rbytes = 0;
+		}
+		if (rbytes == 0) {
+			rlo = lo;
+		}
+		rhi = hi;
+		rbytes += used;
+	}
+	if (npages > 0) {
+		fprintf(fp, "%6d  0x%08lx  0x%08lx  %lu\n", region, rlo, rhi - 1, rbytes);
+	}
+	fprintf(fp, "Total                           %lu\n", nbytes);
+}
+
+/* Output an element or a range of equal elements of a MIF file */
+void mifelement(FILE *fp, unsigned long int first, unsigned long int last,
+		unsigned char code[], int size) {
+
+	if (first == last) {
+		fprintf(fp, "%4lx : ", first);
+	} else {
+		fprintf(fp, "[%lx..%lx] : ", first, last);
+	}
+	for (int i = 0; i < size; i++) {
+		fprintf(fp, "%02x", code[i]);
+	}
+	fprintf(fp, ";\n");
+}
+
+/* Write a MIF file of the elements from start to end,
+ * elements without data are zero */
+void writemif(FILE *fp, unsigned long int start, unsigned long int end, int size) {
+	unsigned char code[WORD], runcode[WORD];
+	unsigned long int first = 0, nrun = 0;
+	unsigned long int depth = (end - start + size - 1) / size;
+
+	fprintf(fp, "WIDTH=%d;\n", size*8);
+	fprintf(fp, "DEPTH=%lu;\n", depth);
+	fprintf(fp, "ADDRESS_RADIX=HEX;\n");
+	fprintf(fp, "DATA_RADIX=HEX;\n\n");
+	fprintf(fp, "CONTENT BEGIN\n\n");
+	for (unsigned long int index = 0; index < depth; index++) {
+		getelement(start + index*size, code, size);
+		/* Extend the current run or start a new one */
+		if (nrun > 0 && memcmp(code, runcode, size) == 0) {
+			nrun++;
+			continue;
+		}
+		if (nrun > 0) {
+			mifelement(fp, first, first + nrun - 1, runcode, size);
+		}
+		memcpy(runcode, code, size);
+		first = index;
+		nrun = 1;
+	}
+	if (nrun > 0) {
+		mifelement(fp, first, first + nrun - 1, runcode, size);
+	}
+	fprintf(fp, "\nEND;\n");
+}
+
+/* Write the bytes from start to end as a flat binary,
+ * bytes without data are zero */
+void writebin(FILE *fp, unsigned long int start, unsigned long int end) {
+	unsigned char byte;
+
+	for (unsigned long int address = start; address < end; address++) {
+		getbyte(address, &byte);
+		fputc(byte, fp);
+	}
+}
+
+/* Write one Intel HEX record */
+void ihexrecord(FILE *fp, int type, unsigned int address, unsigned char data[], int len) {
+	unsigned int sum = len + (address >> 8) + address + type;
+
+	fprintf(fp, ":%02X%04X%02X", len, address & 0xffff, type);
+	for (int i = 0; i < len; i++) {
+		fprintf(fp, "%02X", data[i]);
+		sum += data[i];
+	}
+	fprintf(fp, "%02X\n", -sum & 0xff);
+}
+
+/* Write the present bytes from start to end as Intel HEX,
+ * with 16 bytes per record */
+void writeihex(FILE *fp, unsigned long int start, unsigned long int end,
+		unsigned long int entry, int haveentry) {
+	unsigned char data[16], ela[4];
+	unsigned long int upper = 0, first = 0;
+	int len = 0;
+
+	for (int n = 0; n < npages; n++) {
+		for (unsigned long int address = pages[n]->addr; address < pages[n]->addr + PAGE_SIZE; address++) {
+			unsigned char byte;
+			int present = address >= start && address < end && getbyte(address, &byte);
+
+			/* Flush on a gap, a full record or a 64 kB boundary */
+			if (len > 0 && (!present || len == 16 || (address & 0xffff) == 0)) {
+				ihexrecord(fp, 0, first, data, len);
+				len = 0;
+			}
+			if (!present) {
+				continue;
+			}
+			if ((address >> 16) != upper) {
+				upper = address >> 16;
+				ela[0] = upper >> 8;
+				ela[1] = upper;
+				ihexrecord(fp, 4, 0, ela, 2);
+			}
+			if (len == 0) {
+				first = address;
+			}
+			data[len++] = byte;
+		}
+	}
+	if (len > 0) {
+		ihexrecord(fp, 0, first, data, len);
+	}
+	if (haveentry) {
+		for (int i = 0; i < 4; i++) {
+			ela[i] = entry >> (24 - 8*i);
+		}
+		ihexrecord(fp, 5, 0, ela, 4);
+	}
+	ihexrecord(fp, 1, 0, NULL, 0);
+}
+
+/* Write the bytes from start to end as a C array, named
+ * after the file. Bytes without data are zero. */
+void writec(FILE *fp, const char *filename, unsigned long int start, unsigned long int end) {
+	const char *base = strrchr(filename, '/');
+	char name[64], upper[64];
+	unsigned char byte;
+	int i;
+
+	base = base == NULL ? filename : base + 1;
+	for (i = 0; base[i] != '\0' && base[i] != '.' && i < (int) sizeof(name) - 1; i++) {
+		name[i] = isalnum((unsigned char) base[i]) ? base[i] : '_';
+		upper[i] = toupper((unsigned char) name[i]);
+	}
+	name[i] = upper[i] = '\0';
+
+	fprintf(fp, "/* Generated by srec2vhdl */\n\n");
+	fprintf(fp, "#define %s_ADDRESS (0x%08lxUL)\n", upper, start);
+	fprintf(fp, "#define %s_SIZE (%luUL)\n\n", upper, end - start);
+	fprintf(fp, "const unsigned char %s[%s_SIZE] = {", name, upper);
+	for (unsigned long int address = start; address < end; address++) {
+		getbyte(address, &byte);
+		fprintf(fp, "%s0x%02x%s", (address - start) % 12 == 0 ? "\n\t" : " ",
+			byte, address + 1 < end ? "," : "");
+	}
+	fprintf(fp, "\n};\n");
+}
+
+/* Open an extra output file */
+FILE *openout(const char *name, const char *mode) {
+	FILE *fp = fopen(name, mode);
+
+	if (fp == NULL) {
+		fprintf(stderr, "Cannot open output file %s\n", name);
+		exit(EXIT_FAILURE);
+	}
+	return fp;
 }
 
 /* main */
 int main(int argc, char *argv[]) {
 
-	FILE *fp, *fout;
-	char buffer[LEN_BUFFER];
-	int line = 0;
-	unsigned long int val;
+	FILE *fout;
+	srec_reader_t r;
+	srec_t rec;
+	int ret;
 	unsigned long int address = 0;
-	unsigned long int byte;
 	int i;
-	int first = 1;
 	unsigned long int offset = 0;
-	//int doindent = 1;
+	/* Bytes of one element */
+	unsigned char code[WORD];
+	/* Range to output */
+	unsigned long int start = 0, end = 0x100000000UL;
+	int range = 0;
+	char *s;
+	/* Current run of equal elements */
+	unsigned char runcode[WORD];
+	unsigned long int first = 0, nrun = 0;
+	unsigned long int nelements = 0;
 
 	/* Options */
 	int indent, opt;
@@ -116,6 +422,12 @@ int main(int argc, char *argv[]) {
 	int indentarg;
 	int size = BYTE;
 	char unused = '-';
+	int compact = 0, datafile = 0, zero;
+	/* Extra outputs, all written from the same image */
+	char *mifname = NULL, *binname = NULL, *hexname = NULL, *cname = NULL;
+	int sizereport = 0;
+	unsigned long int flatend, entry = 0;
+	int haveentry = 0;
 
 	/* Set defaults on options */
 	full = 0;
@@ -126,7 +438,7 @@ int main(int argc, char *argv[]) {
 	/* Check for 0 extra arguments */
 	if (argc == 1) {
 		printf("srec2vhdl " VERSION " -- an S-record to VHDL table converter\n");
-		printf("Usage: srec2vhdl [-vqfbhw0 -i <arg>] inputfile [outputfile]\n");
+		printf("Usage: srec2vhdl [-vqfbhw0ctS -i <arg> -r <s>:<l> -m|-B|-x|-C <file>] inputfile [outputfile]\n");
 		printf("   -f        Full table output\n");
 		printf("   -i <arg>  Indent by <arg> spaces\n");
 		printf("   -v        Verbose\n");
@@ -135,15 +447,22 @@ int main(int argc, char *argv[]) {
 		printf("   -h        Halfword output (16 bits, Little Endian)\n");
 		printf("   -w        Word output (32 bits, Little Endian)\n");
 		printf("   -0        Output unused data as 0's (default is - (don't care))\n");
-		printf("If outputfile is omitted, stdout is used\n");
-		printf("Program size must be less then 1 MB\n\n");
-		printf("The address of the first record is used as an offset\n"
-                       "so that the first record starts at vector element 0.\n");
+		printf("   -r <s>:<l> Only output the l bytes from address s\n");
+		printf("   -c        Compact output, equal elements as ranges\n");
+		printf("   -t        Output a data file for rom.vhd (textio)\n");
+		printf("   -m <file> Also write a MIF file\n");
+		printf("   -B <file> Also write a flat binary file\n");
+		printf("   -x <file> Also write an Intel HEX file\n");
+		printf("   -C <file> Also write a C header with an array\n");
+		printf("   -S        Print the size of each region\n");
+		printf("If outputfile is omitted, stdout is used\n\n");
+		printf("The lowest address (or the start of the range) is used as\n"
+                       "an offset so that it starts at vector element 0.\n");
 		exit(EXIT_SUCCESS);
 	}
 
 	/* Parse options */
-	while ((opt = getopt(argc, argv, "0bhwvqfi:")) != -1) {
+	while ((opt = getopt(argc, argv, "0bhwvqfi:r:ctm:B:x:C:S")) != -1) {
 	        switch (opt) {
        		case 'f':
 	            full = 1;
@@ -166,6 +485,36 @@ int main(int argc, char *argv[]) {
 	        case 'w':
 	            size = WORD;
 	            break;
+	        case 'r':
+	            start = strtoul(optarg, &s, 0);
+	            if (*s != ':') {
+	                fprintf(stderr, "Range must be <start>:<length>\n");
+	                exit(EXIT_FAILURE);
+	            }
+	            end = start + strtoul(s+1, NULL, 0);
+	            range = 1;
+	            break;
+	        case 'c':
+	            compact = 1;
+	            break;
+	        case 't':
+	            datafile = 1;
+	            break;
+	        case 'm':
+	            mifname = optarg;
+	            break;
+	        case 'B':
+	            binname = optarg;
+	            break;
+	        case 'x':
+	            hexname = optarg;
+	            break;
+	        case 'C':
+	            cname = optarg;
+	            break;
+	        case 'S':
+	            sizereport = 1;
+	            break;
 	        case 'q':
 	            verbose = 0;
 	        case '0':
@@ -177,6 +526,14 @@ int main(int argc, char *argv[]) {
 	        }
 	}
 
+	/* A data file has no VHDL around it and the ROM is
+	 * cleared before it is read */
+	if (datafile) {
+		full = 0;
+		indent = 0;
+	}
+	zero = datafile || (full && unused == '0');
+
 	if (verbose) {
 		fprintf(stderr, "srec2vhdl " VERSION " \n");
 		fprintf(stderr, "S-record to VHDL converter\n");
@@ -187,9 +544,8 @@ int main(int argc, char *argv[]) {
 	    exit(EXIT_FAILURE);
 	}
 
-	fp = fopen(argv[optind], "r");
-	if (fp == NULL) {
-		fprintf(stderr, "Cannot open input file %s\n", argv[1]);
+	if (srec_open(&r, argv[optind]) < 0) {
+		fprintf(stderr, "Cannot open input file %s\n", argv[optind]);
 		exit (EXIT_FAILURE);
 	}
 
@@ -202,12 +558,12 @@ int main(int argc, char *argv[]) {
 	} else {
 		if (strcmp(argv[optind], argv[optind+1]) == 0) {
 			fprintf(stderr, "Input filename and output filename cannot be the same\n");
-			fclose(fp);
+			srec_close(&r);
 			exit(EXIT_FAILURE);
 		}
 		fout = fopen(argv[optind+1], "w");
 		if (fout == NULL) {
-			fclose(fp);
+			srec_close(&r);
 			fprintf(stderr, "Cannot open output file %s\n", argv[optind+1]);
 			exit(EXIT_FAILURE);
 		}
@@ -224,146 +580,145 @@ int main(int argc, char *argv[]) {
 		fprintf(fout, "    constant rom_contents : rom_type := (\n");
 	}
 
-	while (fgets(buffer, LEN_BUFFER, fp) != NULL) {
-		line++;
-		if (buffer[0] != 'S') {
-			fprintf(stderr, "Not an S-record in line %d!\n", line);
+	while ((ret = srec_read(&r, &rec)) != SREC_EOF) {
+		if (ret == SREC_ERR_NOTSREC) {
+			fprintf(stderr, "Not an S-record in line %d!\n", r.line);
 			continue;
 		}
-		val = 0;
-		switch (buffer[1]) {
-			case '0': val = hex2(buffer+2);
-				  val = val - 3;
-				  if (verbose) {
-				  	fprintf(stderr, "Vendor text: ");
-				  	for (i = 0; i < val; i++) {
-						char c = (char) hex2(buffer+8+i*2);
-						fprintf(stderr, "%c", c);
-					}
-				  	fprintf(stderr, "\n");
-				  }
-				  break;
-			case '1': val = hex2(buffer+2);
-				  val = val-3;
-				  address = hex4(buffer+4);
-				  if (first) {
-					  offset = address;
-					  if (verbose) {
-					  	  fprintf(stderr, "Offset: 0x%08lx\n", offset);
-					  }
-					  first = 0;
-				  }
-				  for (i = 0; i < val; i++) {
-					byte = hex2(buffer+8+i*2);
-					code[address-offset] = byte;
-					address++;
-				  }
-				  break;
-			case '2': val = hex2(buffer+2);
-				  val = val-4;
-				  address = hex6(buffer+4);
-				  if (first) {
-					  offset = address;
-					  if (verbose) {
-					  	  fprintf(stderr, "Offset: 0x%08lx\n", offset);
-					  }
-					  first = 0;
-				  }
-				  for (i = 0; i < val; i++) {
-					byte = hex2(buffer+10+i*2);
-					code[address-offset] = byte;
-					address++;
+		if (ret < 0) {
+			fprintf(stderr, "%s in line %d!\n", srec_strerror(ret), r.line);
+			srec_close(&r);
+			fclose(fout);
+			exit(EXIT_FAILURE);
+		}
+		switch (rec.type) {
+			case 0:   if (verbose) {
+				  	fprintf(stderr, "Vendor text: %.*s\n", rec.len, (char *) rec.data);
 				  }
 				  break;
-			case '3': val = hex2(buffer+2);
-				  val = val-5;
-				  address = hex8(buffer+4);
-				  if (first) {
-					  offset = address;
-					  if (verbose) {
-					  	  fprintf(stderr, "Offset: 0x%08lx\n", offset);
-					  }
-					  first = 0;
-				  }
-				  for (i = 0; i < val; i++) {
-					byte = hex2(buffer+12+i*2);
-					code[address-offset] = byte;
-					address++;
+			case 1:
+			case 2:
+			case 3:   for (i = 0; i < rec.len; i++) {
+					putbyte(rec.address + i, rec.data[i]);
 				  }
 				  break;
-			case '4': if (verbose) {
+			case 4:   if (verbose) {
 					  fprintf(stderr, "Reserved S-record\n");
 				  }
 				  break;
-			case '5': if (verbose) {
+			case 5:
+			case 6:   if (verbose) {
 					  fprintf(stderr, "Optional count record skipped\n");
 				  }
 				  break;
-			case '6': if (verbose) {
-					  fprintf(stderr, "Optional count record skipped\n");
-				  }
-				  break;
-			case '7': if (verbose) {
-					  fprintf(stderr, "Termination record\n");
-				  }
-				  break;
-			case '8': if (verbose) {
-					  fprintf(stderr, "Termination record\n");
-				  }
-				  break;
-			case '9': if (verbose) {
+			default:  if (verbose) {
 					  fprintf(stderr, "Termination record\n");
 				  }
-				  break;
-			default : if (verbose) {
-					  fprintf(stderr, "Invalid S-record in line %d\n", line);
-				  }
+				  entry = rec.address;
+				  haveentry = 1;
 				  break;
 		}
+	}
 
+	/* Output the pages in address order, with the lowest
+	 * address or the start of the range as offset */
+	qsort(pages, npages, sizeof(page_t *), pagecmp);
+	if (range) {
+		offset = start;
+	} else if (npages > 0) {
+		for (offset = pages[0]->addr; !getbyte(offset, &code[0]); offset++);
+	}
+	if (verbose) {
+		fprintf(stderr, "Offset: 0x%08lx\n", offset);
 	}
 
-	/* Shift to length of data in array */
-	address -= offset;
+	/* Next element to output, elements never overlap */
+	address = offset;
+	for (int n = 0; n < npages; n++) {
+		unsigned long int pend = pages[n]->addr + PAGE_SIZE;
 
-	if (address > LEN_CODE) {
-		fprintf(stderr, "Warning: internal buffer too small, not exporting all data!\n");
-		address = LEN_CODE;
-	}
+		if (verbose && (n == 0 || pages[n-1]->addr + PAGE_SIZE != pages[n]->addr)) {
+			fprintf(stderr, "Region at 0x%08lx\n", pages[n]->addr);
+		}
+		/* Skip to the first element in this page */
+		if (address < pages[n]->addr) {
+			address += (pages[n]->addr - address) / size * size;
+		}
+		for (; address < pend && address < end; address += size) {
+			int present = 0;
+			unsigned long int index = (address-offset)/size;
 
-	for (i = 0; i < address; i = i + size) {
-		if (indent) {
-			for (int i = 0; i < indentarg; i++) {
-				fprintf(fout, " ");
+			for (i = 0; i < size; i++) {
+				present |= getbyte(address+i, &code[i]);
 			}
-		}
-		if (size == BYTE) {
-			fprintf(fout, "%4d => x\"%02x\",\n", i/size, code[i]);
-		} else if (size == HALFWORD) {
-			fprintf(fout, "%4d => x\"%02x%02x\",\n", i/size, code[i], code[i+1]);
-		} else if (size == WORD) {
-			fprintf(fout, "%4d => x\"%02x%02x%02x%02x\",\n", i/size, code[i], code[i+1], code[i+2], code[i+3]);
-		} else {
-			fprintf(stderr, "BUG:: size unknown\n");
+			if (!present) {
+				continue;
+			}
+			/* Zero elements are covered by the default */
+			if (compact && zero && memcmp(code, "\0\0\0\0", size) == 0) {
+				continue;
+			}
+			/* Extend the current run or start a new one */
+			if (compact && nrun > 0 && index == first + nrun && memcmp(code, runcode, size) == 0) {
+				nrun++;
+				continue;
+			}
+			if (nrun > 0) {
+				putelement(fout, first, first + nrun - 1, runcode, size, indent ? indentarg : 0, datafile);
+				nelements++;
+			}
+			memcpy(runcode, code, size);
+			first = index;
+			nrun = 1;
 		}
 	}
+	if (nrun > 0) {
+		putelement(fout, first, first + nrun - 1, runcode, size, indent ? indentarg : 0, datafile);
+		nelements++;
+	}
 
 	if (full) {
-		if (indent) {
-			for (int i = 0; i < indentarg; i++) {
-				fprintf(fout, " ");
-			}
-		}
+		fprintf(fout, "%*s", indent ? indentarg : 0, "");
 		fprintf(fout, "others => (others => '%c')\n", unused);
        		fprintf(fout, "    );\n");
 		fprintf(fout, "end package processor_common_rom;\n");
 	}
 
+	/* The flat formats cover the range or the region at the
+	 * offset, Intel HEX has all data in the range */
+	flatend = range ? end : regionend(offset);
+	if (!range && (mifname != NULL || binname != NULL || cname != NULL) && npages > 0 && flatend < pages[npages-1]->addr) {
+		fprintf(stderr, "Only the region at 0x%08lx is written, use -r for others\n", offset);
+	}
+	if (mifname != NULL) {
+		FILE *fp = openout(mifname, "w");
+		writemif(fp, offset, flatend, size);
+		fclose(fp);
+	}
+	if (binname != NULL) {
+		FILE *fp = openout(binname, "wb");
+		writebin(fp, offset, flatend);
+		fclose(fp);
+	}
+	if (hexname != NULL) {
+		FILE *fp = openout(hexname, "w");
+		writeihex(fp, range ? start : 0, end, entry, haveentry);
+		fclose(fp);
+	}
+	if (cname != NULL) {
+		FILE *fp = openout(cname, "w");
+		writec(fp, cname, offset, flatend);
+		fclose(fp);
+	}
+	if (sizereport) {
+		report(stderr);
+	}
+
 	if (verbose) {
-		fprintf(stderr, "Transformed %lu bytes.\n", address);
+		fprintf(stderr, "Transformed %lu bytes in %d pages to %lu elements.\n", nbytes, npages, nelements);
 	}
 
-	fclose(fp);
+	srec_close(&r);
 	fclose(fout);
 
 	return 0;
@@ -1,10 +1,396 @@
 #include <stdio.h>
 #include <errno.h>
-#include <fcntl.h> 
+#include <fcntl.h>
 #include <string.h>
 #include <termios.h>
 #include <unistd.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <getopt.h>
+#include <elf.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/time.h>
+
+/* Binary transfer: maximum payload per frame, must
+ * not exceed BIN_MAXLEN of the bootloader */
+#define BIN_BLOCK (256)
+/* Header and CRC bytes of a frame */
+#define BIN_OVERHEAD (8+4)
+/* Binary frame types and responses, see bootloader/binload.h */
+#define BIN_DATA 'D'
+#define BIN_PACKED 'C'
+#define BIN_ENTRY 'E'
+#define BIN_END 'Z'
+#define BIN_ACK 'A'
+#define BIN_NAK 'N'
+/* Number of times a frame is sent before giving up */
+#define BIN_RETRIES (5)
+/* Maximum number of frames in flight, keeps the 8-bit
+ * sequence numbers in flight unique */
+#define BIN_MAXWINDOW (128)
+
+/* Compression: minimum and maximum copy length, maximum
+ * literal run, maximum raw bytes per frame, hash chains */
+#define PACK_MINMATCH (3)
+#define PACK_MAXMATCH (130)
+#define PACK_MAXLIT (128)
+#define PACK_MAXRAW (16384)
+#define PACK_HASHBITS (12)
+#define PACK_HASH(p) ((((p)[0] << 8) ^ ((p)[1] << 4) ^ (p)[2]) & ((1 << PACK_HASHBITS) - 1))
+#define PACK_CHAIN (256)
+
+/* Baud rate negotiation: test pattern and confirm byte, see
+ * bootloader/usart.h, and the time the bootloader needs to fall
+ * back, in micro seconds */
+#define BAUD_PATTERN { 0x55, 0xaa, 0x00, 0xff, 0x0f, 0xf0, 0x33, 0xcc }
+#define BAUD_CONFIRM (0xa5)
+#define BAUD_FALLBACK (500000)
+/* Default maximum baud rate */
+#define BAUD_DEFAULT (115200)
+
+/* Delta upload: size of the blocks that are compared with
+ * the CRCs reported by the bootloader, a multiple of SREC_BYTES */
+#define DELTA_BLOCK (256)
+
+/* Initial size of the transmit queue, size of the receive
+ * buffer and maximum length of a reply line */
+#define TX_BUFLEN (4096)
+#define RX_BUFLEN (256)
+#define RX_MAXLINE (65536)
+
+/* Maximum number of devices uploaded in parallel */
+#define MAX_DEVICES (32)
+
+/* Maximum number of non-contiguous segments in an image */
+#define MAX_SEGMENTS (64)
+/* Number of data bytes per generated S-record */
+#define SREC_BYTES (16)
+
+/* A contiguous block of data */
+typedef struct {
+	uint32_t addr;
+	uint32_t len;
+	uint32_t size;
+	unsigned char *data;
+} segment_t;
+
+/* The program image, as read from the input file */
+typedef struct {
+	segment_t seg[MAX_SEGMENTS];
+	int nseg;
+	uint32_t entry;
+	int has_entry;
+} image_t;
+
+/* The options, the same for all devices */
+typedef struct {
+	int verbose;
+	int quiet;
+	int timeout;
+	int jump;
+	int slepe;
+	int ascii;
+	int maxwindow;
+	int maxbaud;
+	int packed;
+	int delta;
+	int stats;
+	int verify;
+	int hwload;
+	/* Read back instead of upload, see --read */
+	uint32_t readaddr;
+	uint32_t readlen;
+	const char *readfile;
+} options_t;
+
+/* A binary frame, ready to be sent */
+typedef struct {
+	unsigned char buf[8+BIN_BLOCK+4];
+	int len;
+	uint32_t addr;
+	int datalen;
+	int rawlen;
+	int acked;
+	int tries;
+} frame_t;
+
+/* Statistics of the upload, see --stats */
+typedef struct {
+	unsigned long txbytes;
+	unsigned long rxbytes;
+	unsigned long records;
+	unsigned long writes;
+	unsigned long reads;
+	double waiting;
+} stats_t;
+
+/* Protocol states of a device, see step() */
+typedef enum {
+	ST_HELLO,		/* ! sent */
+	ST_BAUD_ASK,		/* R sent */
+	ST_BAUD_RATE,		/* Baud rate proposed */
+	ST_BAUD_ECHO,		/* Test pattern sent at the new rate */
+	ST_BAUD_SYNC,		/* New rate confirmed */
+	ST_BAUD_WAIT,		/* Back at 9600, the bootloader falls back */
+	ST_BAUD_RESYNC,		/* Newline sent at 9600 */
+	ST_BAUD_RESYNC_NEW,	/* Newline sent at the new rate */
+	ST_DELTA_ASK,		/* H sent for the block CRCs of a segment */
+	ST_DELTA_CRCS,		/* Segment sent, block CRCs expected */
+	ST_HWLOAD_ASK,		/* L sent */
+	ST_HWLOAD_STATUS,	/* Records sent, status expected */
+	ST_BIN_ASK,		/* B sent */
+	ST_BIN,			/* Frames in flight */
+	ST_SREC,		/* S-record sent */
+	ST_SREC_END,		/* S7 record sent */
+	ST_VERIFY_ASK,		/* H sent for the CRC of a segment */
+	ST_VERIFY_CRC,		/* Segment sent, CRC expected */
+	ST_READ_ASK,		/* G sent */
+	ST_READ_HEADER,		/* Header of a frame expected */
+	ST_READ_DATA,		/* Data and CRC of a frame expected */
+	ST_READ_IDLE,		/* Lost track of the frames */
+	ST_END,			/* J or # sent */
+	ST_DONE,
+	ST_FAILED
+} state_t;
+
+/* A device with its own protocol state, all devices are
+ * handled by one event loop, see run() */
+typedef struct {
+	const char *name;
+	int fd;
+	state_t state;
+	image_t *img;
+	options_t *opt;
+	/* Exit status, start and end time */
+	int status;
+	double start, end;
+	/* Time at which the reply times out */
+	double deadline;
+	/* Transmit queue, written when the device accepts data */
+	unsigned char *txbuf;
+	int txpos, txlen, txsize;
+	/* Sleep after each character, and time of the next one */
+	int slepe;
+	double txnext;
+	/* Baud rate, and time at which the written data is sent */
+	int rate;
+	double txdone;
+	/* Bytes read but not handled yet */
+	unsigned char in[RX_BUFLEN];
+	int inpos, inlen;
+	/* Reply: up to the newline if rxneed is 0, else rxneed
+	 * bytes. With rxneed -1, input is ignored */
+	unsigned char *rxbuf;
+	int rxlen, rxsize, rxneed;
+	/* Baud rate negotiation: index in baudrates */
+	int baud;
+	/* Segment and offset of the CRCs or S-records */
+	int seg;
+	uint32_t off;
+	int changed, total, mismatch;
+	/* Per segment and DELTA_BLOCK: 1 if the target has the data */
+	unsigned char *same[MAX_SEGMENTS];
+	/* Binary frames, oldest not acknowledged, next to send */
+	frame_t *frames;
+	int nframes, first, next, window;
+	/* Read back: data, received blocks, block to ask for */
+	unsigned char *data, *got;
+	int nblocks, block, tries;
+	uint32_t readaddr, readlen;
+	unsigned char frame[8+BIN_BLOCK+4];
+	stats_t stats;
+} device_t;
+
+/* CRC32 (IEEE 802.3) lookup table, filled by crc32_init */
+static uint32_t crc_table[256];
+
+void crc32_init(void)
+{
+	for (uint32_t i = 0; i < 256; i++) {
+		uint32_t c = i;
+		for (int j = 0; j < 8; j++) {
+			c = (c & 1) ? (c >> 1) ^ 0xedb88320U : c >> 1;
+		}
+		crc_table[i] = c;
+	}
+}
+
+/* Update CRC32 with len bytes, start with crc = 0 */
+uint32_t crc32(uint32_t crc, const unsigned char *buf, size_t len)
+{
+	crc = ~crc;
+	while (len--) {
+		crc = (crc >> 8) ^ crc_table[(crc ^ *buf++) & 0xff];
+	}
+	return ~crc;
+}
+
+/* Add a byte to the image at address addr. Bytes that
+ * follow the last byte of a segment extend that segment */
+int image_add(image_t *img, uint32_t addr, unsigned char byte)
+{
+	segment_t *seg = NULL;
+
+	for (int i = 0; i < img->nseg; i++) {
+		if (img->seg[i].addr + img->seg[i].len == addr) {
+			seg = &img->seg[i];
+			break;
+		}
+	}
+
+	if (seg == NULL) {
+		if (img->nseg == MAX_SEGMENTS) {
+			fprintf(stderr, "Too many segments in image\n");
+			return -1;
+		}
+		seg = &img->seg[img->nseg++];
+		seg->addr = addr;
+		seg->len = 0;
+		seg->size = 0;
+		seg->data = NULL;
+	}
+
+	if (seg->len == seg->size) {
+		seg->size = seg->size ? seg->size * 2 : 4096;
+		seg->data = realloc(seg->data, seg->size);
+		if (seg->data == NULL) {
+			fprintf(stderr, "Out of memory\n");
+			return -1;
+		}
+	}
+	seg->data[seg->len++] = byte;
+
+	return 0;
+}
+
+void image_free(image_t *img)
+{
+	for (int i = 0; i < img->nseg; i++) {
+		free(img->seg[i].data);
+	}
+	img->nseg = 0;
+}
+
+/* Convert one hex digit, returns -1 if not a hex digit */
+int hexdigit(int c)
+{
+	if (c >= '0' && c <= '9') {
+		return c - '0';
+	} else if (c >= 'a' && c <= 'f') {
+		return c - 'a' + 10;
+	} else if (c >= 'A' && c <= 'F') {
+		return c - 'A' + 10;
+	}
+	return -1;
+}
+
+/* Read an S-record file in the image */
+int load_srec(FILE *fin, image_t *img)
+{
+	char line[1000];
+	unsigned char rec[256];
+	int linenr = 0;
+
+	while (fgets(line, sizeof line, fin)) {
+		int len, alen, sum = 0;
+
+		linenr++;
+		if (line[0] != 'S') {
+			continue;
+		}
+		/* Convert hex pairs after the type to bytes */
+		for (len = 0; len < sizeof rec; len++) {
+			int h = hexdigit(line[2+len*2]);
+			int l = h < 0 ? -1 : hexdigit(line[3+len*2]);
+			if (l < 0) {
+				break;
+			}
+			rec[len] = (h << 4) | l;
+			sum += rec[len];
+		}
+		if (len < 1 || rec[0] != len - 1 || (sum & 0xff) != 0xff) {
+			fprintf(stderr, "Invalid S-record in line %d\n", linenr);
+			return -1;
+		}
+		switch (line[1]) {
+			case '1': case '9': alen = 2; break;
+			case '2': case '8': alen = 3; break;
+			case '3': case '7': alen = 4; break;
+			default: continue;
+		}
+		if (len < alen + 2) {
+			fprintf(stderr, "Invalid S-record in line %d\n", linenr);
+			return -1;
+		}
+		uint32_t addr = 0;
+		for (int i = 0; i < alen; i++) {
+			addr = (addr << 8) | rec[1+i];
+		}
+		if (line[1] >= '7') {
+			/* Termination record with start address */
+			img->entry = addr;
+			img->has_entry = 1;
+			continue;
+		}
+		for (int i = 1 + alen; i < len - 1; i++) {
+			if (image_add(img, addr++, rec[i]) < 0) {
+				return -1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+/* Read the loadable segments of a RISC-V ELF file in the
+ * image. Only the bytes in the file are used, so .bss is not
+ * sent. Data is placed at the physical (load) address, as with
+ * objcopy, and the start address is the ELF entry point */
+int load_elf(FILE *fin, image_t *img)
+{
+	Elf32_Ehdr ehdr;
+	Elf32_Phdr phdr;
+
+	if (fread(&ehdr, sizeof ehdr, 1, fin) != 1 ||
+	    ehdr.e_ident[EI_CLASS] != ELFCLASS32 ||
+	    ehdr.e_ident[EI_DATA] != ELFDATA2LSB ||
+	    ehdr.e_machine != EM_RISCV ||
+	    ehdr.e_phentsize != sizeof phdr) {
+		fprintf(stderr, "Not a 32-bit RISC-V ELF file\n");
+		return -1;
+	}
+
+	for (int i = 0; i < ehdr.e_phnum; i++) {
+		if (fseek(fin, ehdr.e_phoff + i * sizeof phdr, SEEK_SET) != 0 ||
+		    fread(&phdr, sizeof phdr, 1, fin) != 1) {
+			fprintf(stderr, "Cannot read program header %d\n", i);
+			return -1;
+		}
+		if (phdr.p_type != PT_LOAD || phdr.p_filesz == 0) {
+			continue;
+		}
+		if (fseek(fin, phdr.p_offset, SEEK_SET) != 0) {
+			fprintf(stderr, "Cannot read segment %d\n", i);
+			return -1;
+		}
+		for (uint32_t j = 0; j < phdr.p_filesz; j++) {
+			int c = fgetc(fin);
+			if (c == EOF) {
+				fprintf(stderr, "Cannot read segment %d\n", i);
+				return -1;
+			}
+			if (image_add(img, phdr.p_paddr + j, c) < 0) {
+				return -1;
+			}
+		}
+	}
+
+	img->entry = ehdr.e_entry;
+	img->has_entry = 1;
+
+	return 0;
+}
 
 int set_interface_attribs(int fd, int speed, int parity)
 {
@@ -65,223 +451,1495 @@ void set_blocking(int fd, int should_block, int timeout)
 	        printf("error %d setting term attributes\n", errno);
 }
 
-int main(int argc, char *argv[]) {
+/* Baud rates proposed to the bootloader, highest first */
+static const struct {
+	int baud;
+	speed_t speed;
+} baudrates[] = {
+	{ 921600, B921600 },
+	{ 460800, B460800 },
+	{ 230400, B230400 },
+	{ 115200, B115200 },
+	{ 57600, B57600 },
+	{ 38400, B38400 },
+	{ 19200, B19200 },
+};
 
-	/* The serial port */	
-	char *portname = "/dev/ttyUSB0";
-	/* Buffer... */
-	char line[1000] = { 0 };
-	/* Number of chars read in via port */
-	int n;
+/* Set the speed of the device after the queued data is sent.
+ * Reads do not block, timeouts are kept by the event loop */
+void set_speed(int fd, speed_t speed)
+{
+	tcdrain(fd);
+	set_interface_attribs(fd, speed, 0);
+	set_blocking(fd, 0, 0);
+}
 
+/* Current time in seconds */
+double now(void)
+{
+	struct timeval tv;
 
-	/* Input file */
-	FILE *fin = NULL;
-	/* Device file descriptor */
-	int fd = 0;
-	int linenr = 0;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
 
-	/* Options */
-	int opt;
-	int verbose = 0;
-	int timeout = 10;
-	int jump = 0;
-	int slepe = 0;
-	int quiet = 0;
+/* Timeout of a reply in seconds */
+double timeout(device_t *d)
+{
+	return d->opt->timeout / 10.0;
+}
 
-	/* Check for 0 extra arguments */
-	if (argc == 1) {
-		printf("upload -v -d <device> -t <timeout> filename\n");
-		printf("Upload S-record file to THUAS RISC-V processor\n");
-		printf("-v           -- verbose\n");
-		printf("-q           -- quiet, only errors\n");
-		printf("-j           -- run application after upload\n");
-		printf("-d <device>  -- serial device\n");
-		printf("-t <timeout> -- timeout in deci seconds\n");
-		printf("-s <sleep>   -- sleep micro seconds after each character\n");
-		exit(EXIT_SUCCESS);
+/* Give up on the device */
+void fail(device_t *d, int status, const char *msg)
+{
+	if (msg != NULL) {
+		printf("%s\n", msg);
 	}
+	d->status = status;
+	d->state = ST_FAILED;
+	d->end = now();
+}
 
-	/* Parse options */
-	while ((opt = getopt(argc, argv, "vd:t:js:q")) != -1) {
-	        switch (opt) {
-	        case 'd':
-	            portname = optarg;
-	            break;
-	        case 'j':
-	            jump = 1;
-	            break;
-	        case 'v':
-	            verbose = 1;
-	        case 'q':
-	            quiet = 1;
-	            break;
-		case 't':
-		    timeout = atoi(optarg);
-		    if (timeout < 0) {
-			    timeout = 0;
-		    }
-		    break;
-		case 's':
-		    slepe = atoi(optarg);
-		    if (slepe < 0) {
-			    slepe = 0;
-		    }
-		    break;
-	        default: /* '?' */
-		    fprintf(stderr, "Unknown option '%c'\n", opt);
-	            exit(EXIT_FAILURE);
-	        }
+/* Add data to the transmit queue, the queue grows as needed.
+ * The data is sent by the event loop */
+void tx_put(device_t *d, const void *buf, int len)
+{
+	if (d->txpos > 0 && d->txpos == d->txlen) {
+		d->txpos = d->txlen = 0;
 	}
-
-	if (optind >= argc) {
-	    fprintf(stderr, "Please supply an input filename\n");
-	    exit(EXIT_FAILURE);
+	if (d->txlen + len > d->txsize) {
+		while (d->txlen + len > d->txsize) {
+			d->txsize = d->txsize ? d->txsize * 2 : TX_BUFLEN;
+		}
+		d->txbuf = realloc(d->txbuf, d->txsize);
+		if (d->txbuf == NULL) {
+			printf("Out of memory\n");
+			exit(EXIT_FAILURE);
+		}
 	}
+	memcpy(d->txbuf + d->txlen, buf, len);
+	d->txlen += len;
+}
+
+void tx_puts(device_t *d, const char *s)
+{
+	tx_put(d, s, strlen(s));
+}
 
-	fin = fopen(argv[optind], "r");
-	if (fin == NULL) {
-		fprintf(stderr, "Cannot open input file %s\n", argv[optind]);
-		exit (EXIT_FAILURE);
+/* Write as much of the transmit queue as the device accepts,
+ * or one character if a sleep after each character is asked for */
+void tx_write(device_t *d)
+{
+	int len = d->slepe > 0 ? 1 : d->txlen - d->txpos;
+	int n = write(d->fd, d->txbuf + d->txpos, len);
+
+	if (n < 0 && errno != EAGAIN && errno != EINTR) {
+		printf("error %d writing %s: %s\n", errno, d->name, strerror(errno));
+		fail(d, -3, NULL);
+		return;
 	}
+	if (n > 0) {
+		double t = now();
 
-	if (verbose) {
-		printf("Serial port is: %s\n", portname);
+		d->txpos += n;
+		d->stats.txbytes += n;
+		d->stats.writes++;
+		/* The reply cannot come before the data is sent, the
+		 * device may buffer more than the line can take */
+		d->txdone = (d->txdone > t ? d->txdone : t) + n * 10.0 / d->rate;
+		d->deadline = d->txdone + timeout(d);
+		if (d->slepe > 0) {
+			d->txnext = t + d->slepe / 1e6;
+		}
 	}
+}
 
-	/* Open the device */	
-	fd = open(portname, O_RDWR | O_NOCTTY | O_SYNC);
+/* Throw away all received data */
+void rx_flush(device_t *d)
+{
+	tcflush(d->fd, TCIFLUSH);
+	d->inpos = d->inlen = 0;
+	d->rxlen = 0;
+}
 
-	/* Check if device is open */
-	if (fd < 0) {
-	        printf("error %d opening %s: %s\n", errno, portname, strerror (errno));
-		fclose(fin);
-		return -1;
-	}
+/* Set the baud rate of the device */
+void dev_speed(device_t *d, int baud, speed_t speed)
+{
+	set_speed(d->fd, speed);
+	d->rate = baud;
+	d->txdone = 0;
+}
 
-	/* Set transmission parameters */
-	set_interface_attribs(fd, B9600, 0);
-	/* Set non-blocking */
-	set_blocking(fd, 0, timeout);
+/* Wait for a reply: a line if len is 0, else len bytes */
+void expect(device_t *d, int len)
+{
+	double t = now();
 
-	/* Write the ! to start uploading */
-	if (verbose) {
-		printf("Sending '!'... ");
-		fflush(stdout);
-	}
-	n = write(fd, "!", 1);
+	d->rxneed = len;
+	d->rxlen = 0;
+	d->deadline = (d->txdone > t ? d->txdone : t) + timeout(d);
+}
 
-	/* Read in data from device */
-	while (1) {
-		n = read(fd, line, 1);
-		if (n == 0) {
-			break;
+/* Ignore all input for the given time */
+void ignore(device_t *d, double t)
+{
+	d->rxneed = -1;
+	d->rxlen = 0;
+	d->deadline = now() + t;
+}
+
+/* Make the next S3 record of the image in line, the blocks
+ * the target already has are skipped. Returns 0 when all
+ * records are made */
+int srec_record(device_t *d, char *line)
+{
+	image_t *img = d->img;
+
+	while (d->seg < img->nseg) {
+		segment_t *seg = &img->seg[d->seg];
+		uint32_t off = d->off;
+		uint32_t addr = seg->addr + off;
+		int n, sum, pos;
+
+		if (off >= seg->len) {
+			d->seg++;
+			d->off = 0;
+			continue;
 		}
-		if (line[0] == '\n') {
-			break;
+		d->off += SREC_BYTES;
+		if (d->same[d->seg] && d->same[d->seg][off / DELTA_BLOCK]) {
+			continue;
 		}
-	}
 
-	if (n == 0) {
-		printf("Cannot contact bootloader!\n");
-		close(fd);
-		fclose(fin);
-		exit(-2);
-	} else {
-		if (verbose) {
-			printf("OK\n");
+		n = seg->len - off < SREC_BYTES ? seg->len - off : SREC_BYTES;
+		sum = n + 5 + (addr >> 24) + (addr >> 16) + (addr >> 8) + addr;
+		pos = sprintf(line, "S3%02X%08X", n + 5, addr);
+		for (int i = 0; i < n; i++) {
+			pos += sprintf(line+pos, "%02X", seg->data[off+i]);
+			sum += seg->data[off+i];
 		}
+		sprintf(line+pos, "%02X\n", ~sum & 0xff);
+		return 1;
 	}
 
-	/* Write the data to the bootloader */
-	while (fgets(line, sizeof line - 2, fin)) {
-		linenr++;
-		if (verbose) {
-			printf("Write ");
-			fflush(stdout);
-		}
-		/* Send data one character at a time */
-		for (int i=0; i < strlen(line); i++) {
-			n = write(fd, line+i, 1);
-			if (verbose) {
-				if (line[i] != '\n' && line[i] != '\r') {
-					printf("%c", line[i]);
+	return 0;
+}
+
+/* Make the S7 record with the start address in line */
+void srec_entry(uint32_t addr, char *line)
+{
+	int sum = 5 + (addr >> 24) + (addr >> 16) + (addr >> 8) + addr;
+
+	sprintf(line, "S705%08X%02X\n", addr, ~sum & 0xff);
+}
+
+/* Build a binary frame */
+void make_frame(frame_t *f, int type, int seq, uint32_t addr, unsigned char *data, int len)
+{
+	unsigned char *frame = f->buf;
+	uint32_t crc;
+
+	frame[0] = type;
+	frame[1] = seq;
+	frame[2] = len;
+	frame[3] = len >> 8;
+	frame[4] = addr;
+	frame[5] = addr >> 8;
+	frame[6] = addr >> 16;
+	frame[7] = addr >> 24;
+	if (len > 0) {
+		memcpy(frame+8, data, len);
+	}
+	crc = crc32(0, frame, 8+len);
+	frame[8+len] = crc;
+	frame[9+len] = crc >> 8;
+	frame[10+len] = crc >> 16;
+	frame[11+len] = crc >> 24;
+
+	f->addr = addr;
+	f->datalen = len;
+	f->rawlen = len;
+	f->len = 12+len;
+	f->acked = 0;
+	f->tries = 0;
+}
+
+/* (Re)send a frame, returns -1 if it has been sent too often */
+int put_frame(device_t *d, frame_t *f)
+{
+	if (f->tries++ == BIN_RETRIES) {
+		return -1;
+	}
+	tx_put(d, f->buf, f->len);
+	d->stats.records++;
+	return 0;
+}
+
+/* Compress raw data for one compressed frame, the format is
+ * described in bootloader/binload.c. Copies only refer to data
+ * in the same frame, so frames can be resent in any order.
+ * Stops when the compressed data would exceed maxout bytes.
+ * Returns the number of raw bytes packed, and the compressed
+ * length in outlen */
+int pack(const unsigned char *data, int len, unsigned char *out, int maxout, int *outlen)
+{
+	static int head[1 << PACK_HASHBITS];
+	static int prev[PACK_MAXRAW];
+	/* Position of the current literal token, -1 if none */
+	int lit = -1;
+	int i = 0, o = 0;
+
+	if (len > PACK_MAXRAW) {
+		len = PACK_MAXRAW;
+	}
+	for (int h = 0; h < (1 << PACK_HASHBITS); h++) {
+		head[h] = -1;
+	}
+
+	while (i < len) {
+		int best = 0, bestoff = 0, n;
+
+		/* Find the longest match in the hash chain */
+		if (i + PACK_MINMATCH <= len) {
+			int chain = 0;
+			for (int j = head[PACK_HASH(data+i)]; j >= 0 && chain < PACK_CHAIN; j = prev[j], chain++) {
+				for (n = 0; n < PACK_MAXMATCH && i + n < len && data[j+n] == data[i+n]; n++);
+				if (n > best) {
+					best = n;
+					bestoff = i - j;
+					if (n == PACK_MAXMATCH) {
+						break;
+					}
 				}
 			}
-			fflush(stdout);
-			usleep(slepe);
 		}
-		memset(line, 0, sizeof line);
-		/* Read in data from device */
-		while (1) {
-			n = read(fd, line, 1);
-			if (n == 0) {
+
+		if (best >= PACK_MINMATCH) {
+			/* Copy token with distance */
+			if (o + 3 > maxout) {
 				break;
 			}
-			if (line[0] == '\n') {
-				break;
+			out[o++] = 0x80 | (best - PACK_MINMATCH);
+			out[o++] = bestoff;
+			out[o++] = bestoff >> 8;
+			lit = -1;
+		} else {
+			/* Literal, start a new run if needed */
+			best = 1;
+			if (lit < 0 || out[lit] == PACK_MAXLIT - 1) {
+				if (o + 2 > maxout) {
+					break;
+				}
+				lit = o;
+				out[o++] = 0;
+			} else {
+				if (o + 1 > maxout) {
+					break;
+				}
+				out[lit]++;
 			}
+			out[o++] = data[i];
 		}
-		if (n == 0) {
-			printf("Nothing read while sending data!\n");
-			close(fd);
-			fclose(fin);
-			exit(-3);
-		} else {
-			if (verbose) {
-				printf("  OK\n");
-			} else if (!quiet) {
-				printf("*");
+
+		/* Add the positions to the hash chains */
+		for (n = 0; n < best; n++, i++) {
+			if (i + PACK_MINMATCH <= len) {
+				int h = PACK_HASH(data+i);
+				prev[i] = head[h];
+				head[h] = i;
 			}
 		}
 	}
 
-	usleep(1000);
+	*outlen = o;
+	return i;
+}
 
-	if (!quiet && !verbose) {
-		printf("\n");
+/* Add a frame to the list of frames, the list grows as needed */
+frame_t *add_frame(frame_t **frames, int *nframes, int *size)
+{
+	if (*nframes == *size) {
+		*size = *size ? *size * 2 : 256;
+		*frames = realloc(*frames, *size * sizeof(frame_t));
+		if (*frames == NULL) {
+			printf("Out of memory\n");
+			return NULL;
+		}
 	}
+	return &(*frames)[(*nframes)++];
+}
 
-	/* Write end of transmission marker */
-	if (jump) {
-		/* Start application */
-		if (verbose) {
-			printf("Write 'J' ");
-			fflush(stdout);
+/* Build the binary frames of the image, with an entry frame if
+ * the image has a start address and an end frame. If packed
+ * is set, data is compressed where it saves at least the
+ * overhead of a frame. Returns -1 if out of memory */
+int build_frames(device_t *d)
+{
+	image_t *img = d->img;
+	unsigned char buf[BIN_BLOCK];
+	frame_t *f;
+	int size = 0;
+
+	for (int s = 0; s < img->nseg; s++) {
+		segment_t *seg = &img->seg[s];
+		unsigned char *same = d->same[s];
+		uint32_t off = 0;
+		while (off < seg->len) {
+			uint32_t run = seg->len - off;
+			int n, raw = 0, len = 0;
+
+			/* Skip blocks the target has, send up to the next one */
+			if (same) {
+				if (same[off / DELTA_BLOCK]) {
+					off += DELTA_BLOCK - off % DELTA_BLOCK;
+					continue;
+				}
+				run = DELTA_BLOCK - off % DELTA_BLOCK;
+				while (off + run < seg->len && !same[(off + run) / DELTA_BLOCK]) {
+					run += DELTA_BLOCK;
+				}
+				if (off + run > seg->len) {
+					run = seg->len - off;
+				}
+			}
+			n = run < BIN_BLOCK ? run : BIN_BLOCK;
+
+			if ((f = add_frame(&d->frames, &d->nframes, &size)) == NULL) {
+				return -1;
+			}
+			/* A compressed frame must save at least the overhead
+			 * of a frame over sending the raw data in data frames */
+			if (d->opt->packed) {
+				raw = pack(seg->data+off, run, buf, BIN_BLOCK, &len);
+			}
+			if (raw + (raw + BIN_BLOCK - 1) / BIN_BLOCK * BIN_OVERHEAD >= len + 2 * BIN_OVERHEAD) {
+				make_frame(f, BIN_PACKED, d->nframes-1, seg->addr + off, buf, len);
+				f->rawlen = raw;
+			} else {
+				make_frame(f, BIN_DATA, d->nframes-1, seg->addr + off, seg->data+off, n);
+			}
+			off += f->rawlen;
 		}
-		n = write(fd, "J", 1);
-	} else {
-		/* Break to bootloader monitor */
-		if (verbose) {
-			printf("Write '#' ");
-			fflush(stdout);
+	}
+	if (img->has_entry) {
+		if ((f = add_frame(&d->frames, &d->nframes, &size)) == NULL) {
+			return -1;
 		}
-		n = write(fd, "#", 1);
+		make_frame(f, BIN_ENTRY, d->nframes-1, img->entry, NULL, 0);
+	}
+	/* The end frame is sent after all others are acknowledged */
+	if ((f = add_frame(&d->frames, &d->nframes, &size)) == NULL) {
+		return -1;
 	}
+	make_frame(f, BIN_END, d->nframes-1, 0, NULL, 0);
 
-	/* Read in data from device */
-	while (1) {
-		n = read(fd, line, 1);
-		if (n == 0) {
-			break;
+	return 0;
+}
+
+/* Fill the window with frames. The end frame is sent on
+ * its own after all other frames are acknowledged */
+void fill_window(device_t *d)
+{
+	int last = d->nframes - 1, window = d->window;
+
+	if (d->first == last) {
+		last = d->nframes;
+		window = 1;
+	}
+	while (d->next < last && d->next - d->first < window) {
+		put_frame(d, &d->frames[d->next++]);
+	}
+	/* Response and sequence number */
+	expect(d, 2);
+}
+
+/* Send J to start the application or # to break to the monitor */
+void end_upload(device_t *d)
+{
+	tx_puts(d, d->opt->jump ? "J" : "#");
+	d->state = ST_END;
+	expect(d, 0);
+}
+
+/* Ask for the CRC32 of a segment to verify it, an older
+ * bootloader responds with ?\n */
+void verify_next(device_t *d)
+{
+	if (d->seg == d->img->nseg) {
+		if (d->mismatch) {
+			fail(d, -4, NULL);
+			return;
 		}
-		if (line[0] == '\n') {
-			break;
+		if (!d->opt->quiet) {
+			printf("Verify OK\n");
 		}
+		end_upload(d);
+		return;
 	}
-	if (n == 0) {
-		printf("Nothing read while sending end of transmission!\n");
-		close(fd);
-		fclose(fin);
-		exit(-3);
+	tx_puts(d, "H");
+	d->state = ST_VERIFY_ASK;
+	expect(d, 0);
+}
+
+/* All data is sent, check the data on the target */
+void data_done(device_t *d)
+{
+	d->slepe = 0;
+	if (!d->opt->quiet && !d->opt->verbose) {
+		printf("\n");
+	}
+	if (d->opt->verify) {
+		d->seg = 0;
+		d->mismatch = 0;
+		verify_next(d);
 	} else {
-		if (verbose) {
-			printf("  OK\n");
-		}
+		end_upload(d);
 	}
+}
+
+/* Send the next S-record and wait for the reply, or the S7
+ * record if the image has a start address */
+void srec_next(device_t *d)
+{
+	char line[100];
+
+	if (srec_record(d, line)) {
+		d->state = ST_SREC;
+	} else if (d->state == ST_SREC_END || !d->img->has_entry) {
+		data_done(d);
+		return;
+	} else {
+		srec_entry(d->img->entry, line);
+		d->state = ST_SREC_END;
+	}
+	if (d->opt->verbose) {
+		printf("Write %s", line);
+	}
+	tx_puts(d, line);
+	d->stats.records++;
+	expect(d, 0);
+}
 
+/* Send the image as S-records, an older bootloader does not
+ * support binary transfer */
+void srec_start(device_t *d)
+{
+	d->seg = 0;
+	d->off = 0;
+	d->slepe = d->opt->slepe;
+	d->txnext = 0;
+	d->state = ST_SREC;
+	srec_next(d);
+}
+
+/* Ask for binary transfer, an older bootloader responds with
+ * ?\n, then use S-records */
+void transfer(device_t *d)
+{
+	if (d->opt->ascii) {
+		srec_start(d);
+		return;
+	}
+	tx_puts(d, "B");
+	d->state = ST_BIN_ASK;
+	expect(d, 0);
+}
+
+/* Ask for the hardware loader if asked for, else transfer
+ * the image with the bootloader */
+void hwload_or_transfer(device_t *d)
+{
+	if (!d->opt->hwload) {
+		transfer(d);
+		return;
+	}
+	tx_puts(d, "L");
+	d->state = ST_HWLOAD_ASK;
+	expect(d, 0);
+}
+
+/* Ask for the block CRCs of the next segment, an older
+ * bootloader responds with ?\n */
+void delta_next(device_t *d)
+{
+	if (d->seg == d->img->nseg) {
+		if (d->opt->verbose) {
+			printf("%d of %d blocks changed\n", d->changed, d->total);
+		}
+		hwload_or_transfer(d);
+		return;
+	}
+	tx_puts(d, "H");
+	d->state = ST_DELTA_ASK;
+	expect(d, 0);
+}
+
+/* Ask for len bytes at addr, which must be the read back
+ * address plus a multiple of BIN_BLOCK */
+void read_request(device_t *d, uint32_t addr, uint32_t len)
+{
+	d->readaddr = addr;
+	d->readlen = len;
+	tx_puts(d, "G");
+	d->state = ST_READ_ASK;
+	expect(d, 0);
+}
+
+/* Write the read back memory to the output file */
+void read_done(device_t *d)
+{
+	options_t *opt = d->opt;
+	FILE *fout = fopen(opt->readfile, "wb");
+
+	if (fout == NULL || fwrite(d->data, 1, opt->readlen, fout) != opt->readlen) {
+		printf("Cannot write output file %s\n", opt->readfile);
+		if (fout != NULL) {
+			fclose(fout);
+		}
+		fail(d, -3, NULL);
+		return;
+	}
+	fclose(fout);
+	if (!opt->quiet) {
+		printf("Read %u bytes at %08x to %s\n", opt->readlen, opt->readaddr, opt->readfile);
+	}
+	end_upload(d);
+}
+
+/* Ask for the next block that is not received correctly. After
+ * every round, the missing blocks are asked for again */
+void read_next(device_t *d)
+{
+	options_t *opt = d->opt;
+	int missing = 0;
+
+	for (; d->block < d->nblocks; d->block++) {
+		if (!d->got[d->block]) {
+			uint32_t off = d->block++ * BIN_BLOCK;
+			read_request(d, opt->readaddr + off,
+				     opt->readlen - off < BIN_BLOCK ? opt->readlen - off : BIN_BLOCK);
+			return;
+		}
+	}
+
+	for (int b = 0; b < d->nblocks; b++) {
+		missing += !d->got[b];
+	}
+	if (missing == 0) {
+		read_done(d);
+		return;
+	}
+	if (d->tries++ == BIN_RETRIES) {
+		printf("%d blocks not received while reading back!\n", missing);
+		fail(d, -3, NULL);
+		return;
+	}
+	if (opt->verbose) {
+		printf("Asking again for %d blocks\n", missing);
+	}
+	d->block = 0;
+	read_next(d);
+}
+
+/* Read back the memory range of the --read option */
+void read_start(device_t *d)
+{
+	options_t *opt = d->opt;
+
+	d->nblocks = (opt->readlen + BIN_BLOCK - 1) / BIN_BLOCK;
+	d->data = malloc(opt->readlen);
+	d->got = calloc(d->nblocks, 1);
+	if (d->data == NULL || d->got == NULL) {
+		printf("Out of memory\n");
+		fail(d, -3, NULL);
+		return;
+	}
+	if (opt->verbose) {
+		printf("Reading %u bytes at %08x...\n", opt->readlen, opt->readaddr);
+	}
+	/* After the first read, the missing blocks are asked for */
+	d->block = d->nblocks;
+	d->tries = 1;
+	read_request(d, opt->readaddr, opt->readlen);
+}
+
+/* The baud rate is set, read back memory or write the image */
+void connected(device_t *d)
+{
+	if (d->opt->readlen > 0) {
+		read_start(d);
+	} else if (d->opt->delta) {
+		if (d->opt->verbose) {
+			printf("Reading block CRCs...\n");
+		}
+		d->seg = 0;
+		d->changed = d->total = 0;
+		delta_next(d);
+	} else {
+		hwload_or_transfer(d);
+	}
+}
+
+/* Propose the next baud rate up to the maximum, an older
+ * bootloader responds with ?\n */
+void baud_next(device_t *d)
+{
+	int n = sizeof baudrates / sizeof baudrates[0];
+
+	while (d->baud < n && baudrates[d->baud].baud > d->opt->maxbaud) {
+		d->baud++;
+	}
+	if (d->baud == n) {
+		connected(d);
+		return;
+	}
+	tx_puts(d, "R");
+	d->state = ST_BAUD_ASK;
+	expect(d, 0);
+}
+
+/* Check that the bootloader is listening. Any character that
+ * is not a command is answered with ?\n */
+void sync_bootloader(device_t *d, state_t state)
+{
+	rx_flush(d);
+	tx_puts(d, "\n");
+	d->state = state;
+	expect(d, 0);
+}
+
+/* The test pattern or the confirmation is lost, fall back to
+ * 9600 and wait for the bootloader to fall back */
+void baud_fallback(device_t *d)
+{
+	if (d->opt->verbose) {
+		printf("Baud rate %d failed\n", baudrates[d->baud].baud);
+	}
+	dev_speed(d, 9600, B9600);
+	d->state = ST_BAUD_WAIT;
+	ignore(d, BAUD_FALLBACK / 1e6);
+}
+
+/* Handle a reply of len bytes in rxbuf, len is -1 on a timeout.
+ * Negotiation of the baud rate: for every rate, the bootloader
+ * is asked if it can make the rate. If so, both sides switch and
+ * the test pattern is sent and must be echoed, after which the
+ * new rate is confirmed. If not, both sides fall back to 9600 bps */
+void step(device_t *d, int len)
+{
+	static const unsigned char pattern[] = BAUD_PATTERN;
+	static const unsigned char confirm = BAUD_CONFIRM;
+	options_t *opt = d->opt;
+	char *line = (char *) d->rxbuf;
+	unsigned char *rx = d->rxbuf;
+	char buf[100];
+	frame_t *f;
+	int i;
+
+	switch (d->state) {
+	case ST_HELLO:
+		if (len < 0) {
+			fail(d, -2, "Cannot contact bootloader!");
+			break;
+		}
+		if (opt->verbose) {
+			printf("Bootloader on %s OK\n", d->name);
+		}
+		/* Negotiate a higher transmission speed */
+		if (opt->maxbaud > 9600) {
+			d->baud = 0;
+			baud_next(d);
+		} else {
+			connected(d);
+		}
+		break;
+
+	case ST_BAUD_ASK:
+		if (len < 0) {
+			fail(d, -3, "Lost contact with bootloader while setting baud rate!");
+		} else if (line[0] != 'R') {
+			if (opt->verbose) {
+				printf("Baud rate negotiation not supported\n");
+			}
+			connected(d);
+		} else {
+			sprintf(buf, "%08X\n", baudrates[d->baud].baud);
+			tx_puts(d, buf);
+			d->state = ST_BAUD_RATE;
+			expect(d, 0);
+		}
+		break;
+
+	case ST_BAUD_RATE:
+		if (len < 0) {
+			fail(d, -3, "Lost contact with bootloader while setting baud rate!");
+		} else if (line[0] != 'R') {
+			if (opt->verbose) {
+				printf("Baud rate %d refused\n", baudrates[d->baud].baud);
+			}
+			d->baud++;
+			baud_next(d);
+		} else {
+			/* Switch and exchange the test pattern */
+			dev_speed(d, baudrates[d->baud].baud, baudrates[d->baud].speed);
+			tx_put(d, pattern, sizeof pattern);
+			d->state = ST_BAUD_ECHO;
+			expect(d, sizeof pattern);
+		}
+		break;
+
+	case ST_BAUD_ECHO:
+		if (len < 0 || memcmp(rx, pattern, sizeof pattern) != 0) {
+			baud_fallback(d);
+		} else {
+			/* Without the confirmation, the bootloader falls back */
+			tx_put(d, &confirm, 1);
+			sync_bootloader(d, ST_BAUD_SYNC);
+		}
+		break;
+
+	case ST_BAUD_SYNC:
+		if (len < 0 || line[0] != '?') {
+			baud_fallback(d);
+		} else {
+			if (opt->verbose) {
+				printf("Baud rate set to %d\n", baudrates[d->baud].baud);
+			}
+			connected(d);
+		}
+		break;
+
+	case ST_BAUD_WAIT:
+		sync_bootloader(d, ST_BAUD_RESYNC);
+		break;
+
+	case ST_BAUD_RESYNC:
+		if (len > 0 && line[0] == '?') {
+			d->baud++;
+			baud_next(d);
+		} else {
+			/* The confirmation may have arrived */
+			dev_speed(d, baudrates[d->baud].baud, baudrates[d->baud].speed);
+			sync_bootloader(d, ST_BAUD_RESYNC_NEW);
+		}
+		break;
+
+	case ST_BAUD_RESYNC_NEW:
+		if (len < 0 || line[0] != '?') {
+			fail(d, -3, "Lost contact with bootloader while setting baud rate!");
+		} else {
+			connected(d);
+		}
+		break;
+
+	case ST_DELTA_ASK:
+		if (len < 0) {
+			fail(d, -3, "Lost contact with bootloader while reading block CRCs!");
+		} else if (line[0] != 'H') {
+			/* Send all blocks */
+			if (opt->verbose) {
+				printf("Block CRCs not supported, sending all\n");
+			}
+			for (int s = 0; s < d->img->nseg; s++) {
+				free(d->same[s]);
+				d->same[s] = NULL;
+			}
+			hwload_or_transfer(d);
+		} else {
+			segment_t *seg = &d->img->seg[d->seg];
+			sprintf(buf, "%08X%08X%08X", seg->addr, seg->len, DELTA_BLOCK);
+			tx_puts(d, buf);
+			d->state = ST_DELTA_CRCS;
+			expect(d, 0);
+		}
+		break;
+
+	case ST_DELTA_CRCS: {
+		segment_t *seg = &d->img->seg[d->seg];
+		int nblocks = (seg->len + DELTA_BLOCK - 1) / DELTA_BLOCK;
+
+		if (len != nblocks * 8 + 1) {
+			fail(d, -3, "Lost contact with bootloader while reading block CRCs!");
+			break;
+		}
+		d->same[d->seg] = calloc(nblocks, 1);
+		if (d->same[d->seg] == NULL) {
+			fail(d, -3, "Out of memory");
+			break;
+		}
+		for (int b = 0; b < nblocks; b++) {
+			uint32_t off = b * DELTA_BLOCK;
+			int n = seg->len - off < DELTA_BLOCK ? seg->len - off : DELTA_BLOCK;
+			char hex[9];
+
+			memcpy(hex, line + b * 8, 8);
+			hex[8] = '\0';
+			d->same[d->seg][b] = strtoul(hex, NULL, 16) == crc32(0, seg->data + off, n);
+			d->changed += !d->same[d->seg][b];
+		}
+		d->total += nblocks;
+		d->seg++;
+		delta_next(d);
+		break;
+	}
+
+	case ST_HWLOAD_ASK:
+		if (len < 0) {
+			fail(d, -3, "Nothing read while requesting the hardware loader!");
+		} else if (line[0] != 'L') {
+			/* An older bootloader or a design without the loader */
+			if (opt->verbose) {
+				printf("No hardware loader, using the bootloader\n");
+			}
+			transfer(d);
+		} else {
+			/* The records are sent back to back, the S7
+			 * record ends the hardware loader */
+			d->seg = 0;
+			d->off = 0;
+			while (srec_record(d, buf)) {
+				if (opt->verbose) {
+					printf("Write %s", buf);
+				} else if (!opt->quiet) {
+					printf("*");
+				}
+				tx_puts(d, buf);
+				d->stats.records++;
+			}
+			srec_entry(d->img->has_entry ? d->img->entry : 0, buf);
+			tx_puts(d, buf);
+			d->stats.records++;
+			fflush(stdout);
+			d->state = ST_HWLOAD_STATUS;
+			expect(d, 0);
+		}
+		break;
+
+	case ST_HWLOAD_STATUS: {
+		unsigned int stat = 0, count = 0;
+
+		if (len < 0) {
+			fail(d, -3, "Nothing read from the hardware loader!");
+			break;
+		}
+		if (sscanf(line, "L%2x%8x", &stat, &count) != 2 || stat != 0x01) {
+			printf("Hardware loader failed, status %02x, %u bytes written\n", stat, count);
+			fail(d, -3, NULL);
+			break;
+		}
+		if (opt->verbose) {
+			printf("Hardware loader wrote %u bytes\n", count);
+		}
+		data_done(d);
+		break;
+	}
+
+	case ST_BIN_ASK:
+		if (len < 0) {
+			fail(d, -3, "Nothing read while requesting binary transfer!");
+			break;
+		}
+		if (line[0] != 'B') {
+			if (opt->verbose) {
+				printf("Binary transfer not supported, using S-records\n");
+			}
+			srec_start(d);
+			break;
+		}
+		/* The bootloader reports the number of frames it accepts in flight */
+		d->window = strtol(line+1, NULL, 16);
+		if (d->window < 1) {
+			d->window = 1;
+		}
+		if (opt->maxwindow > 0 && opt->maxwindow < d->window) {
+			d->window = opt->maxwindow;
+		}
+		if (d->window > BIN_MAXWINDOW) {
+			d->window = BIN_MAXWINDOW;
+		}
+		if (opt->verbose) {
+			printf("Binary transfer, window is %d frames\n", d->window);
+		}
+		if (build_frames(d) < 0) {
+			fail(d, -3, NULL);
+			break;
+		}
+		d->first = d->next = 0;
+		d->state = ST_BIN;
+		fill_window(d);
+		break;
+
+	case ST_BIN:
+		if (len < 0) {
+			/* Nothing (more) read, resend all frames in flight */
+			rx_flush(d);
+			for (i = d->first; i < d->next; i++) {
+				if (!d->frames[i].acked && put_frame(d, &d->frames[i]) < 0) {
+					fail(d, -3, i < d->nframes - 1 ? "Frame not acknowledged while sending data!" :
+					     "Frame not acknowledged while ending binary mode!");
+					return;
+				}
+			}
+			expect(d, 2);
+			break;
+		}
+
+		/* Find the frame in flight, skip stale responses */
+		for (i = d->first; i < d->next; i++) {
+			if (d->frames[i].buf[1] == rx[1] && !d->frames[i].acked) {
+				break;
+			}
+		}
+		f = &d->frames[i];
+		if (rx[0] != BIN_ACK && rx[0] != BIN_NAK) {
+			/* Out of sync, wait for a timeout */
+			rx_flush(d);
+		} else if (i < d->next && rx[0] == BIN_NAK) {
+			if (opt->verbose) {
+				printf("Frame %3d: NAK, resending\n", f->buf[1]);
+			}
+			if (put_frame(d, f) < 0) {
+				fail(d, -3, i < d->nframes - 1 ? "Frame not acknowledged while sending data!" :
+				     "Frame not acknowledged while ending binary mode!");
+				break;
+			}
+		} else if (i < d->next) {
+			f->acked = 1;
+			if (opt->verbose) {
+				printf("Frame %3d: %08x, %3d bytes", f->buf[1], f->addr, f->rawlen);
+				if (f->rawlen != f->datalen) {
+					printf(" packed to %d", f->datalen);
+				}
+				printf("  OK\n");
+			} else if (!opt->quiet && i < d->nframes - 1) {
+				printf("*");
+				fflush(stdout);
+			}
+		}
+
+		/* Slide the window */
+		while (d->first < d->next && d->frames[d->first].acked) {
+			d->first++;
+		}
+		if (d->first == d->nframes) {
+			free(d->frames);
+			d->frames = NULL;
+			data_done(d);
+		} else {
+			fill_window(d);
+		}
+		break;
+
+	case ST_SREC:
+	case ST_SREC_END:
+		if (len < 0) {
+			fail(d, -3, "Nothing read while sending data!");
+			break;
+		}
+		if (!opt->quiet && !opt->verbose && d->state == ST_SREC) {
+			printf("*");
+			fflush(stdout);
+		}
+		srec_next(d);
+		break;
+
+	case ST_VERIFY_ASK:
+		if (len < 0) {
+			fail(d, -3, "Lost contact with bootloader while verifying!");
+		} else if (line[0] != 'H') {
+			fail(d, -4, "Verify not supported by the bootloader");
+		} else {
+			segment_t *seg = &d->img->seg[d->seg];
+			sprintf(buf, "%08X%08X%08X", seg->addr, seg->len, seg->len);
+			tx_puts(d, buf);
+			d->state = ST_VERIFY_CRC;
+			expect(d, 0);
+		}
+		break;
+
+	case ST_VERIFY_CRC: {
+		segment_t *seg = &d->img->seg[d->seg];
+		uint32_t crc, local = crc32(0, seg->data, seg->len);
+
+		if (len != 9) {
+			fail(d, -3, "Lost contact with bootloader while verifying!");
+			break;
+		}
+		line[8] = '\0';
+		crc = strtoul(line, NULL, 16);
+		if (crc != local) {
+			printf("Verify failed: %08x, %u bytes, CRC %08x, expected %08x\n",
+			       seg->addr, seg->len, crc, local);
+			d->mismatch = 1;
+		} else if (opt->verbose) {
+			printf("Verify %08x, %u bytes, CRC %08x  OK\n", seg->addr, seg->len, crc);
+		}
+		d->seg++;
+		verify_next(d);
+		break;
+	}
+
+	case ST_READ_ASK:
+		if (len < 0) {
+			fail(d, -3, "Lost contact with bootloader while reading back!");
+		} else if (line[0] != 'G') {
+			fail(d, -3, "Read back not supported by the bootloader");
+		} else {
+			sprintf(buf, "%08X%08X", d->readaddr, d->readlen);
+			tx_puts(d, buf);
+			d->state = ST_READ_HEADER;
+			expect(d, 8);
+		}
+		break;
+
+	case ST_READ_HEADER:
+		if (len < 0) {
+			/* The frames stopped */
+			read_next(d);
+			break;
+		}
+		i = rx[2] | (rx[3] << 8);
+		if ((rx[0] != BIN_DATA && rx[0] != BIN_END) || i > BIN_BLOCK) {
+			/* Lost track of the frames, wait until the line is idle */
+			d->state = ST_READ_IDLE;
+			ignore(d, timeout(d));
+			break;
+		}
+		memcpy(d->frame, rx, 8);
+		d->state = ST_READ_DATA;
+		expect(d, i + 4);
+		break;
+
+	case ST_READ_DATA: {
+		unsigned char *fr = d->frame;
+		uint32_t n, a, crc;
+
+		if (len < 0) {
+			read_next(d);
+			break;
+		}
+		n = fr[2] | (fr[3] << 8);
+		memcpy(fr + 8, rx, n + 4);
+		d->stats.records++;
+		d->state = ST_READ_HEADER;
+		expect(d, 8);
+
+		crc = fr[8+n] | (fr[9+n] << 8) | (fr[10+n] << 16) | ((uint32_t) fr[11+n] << 24);
+		if (crc != crc32(0, fr, 8 + n)) {
+			break;
+		}
+		if (fr[0] == BIN_END) {
+			read_next(d);
+			break;
+		}
+		a = fr[4] | (fr[5] << 8) | (fr[6] << 16) | ((uint32_t) fr[7] << 24);
+		if (a < d->readaddr || a - d->readaddr + n > d->readlen ||
+		    (a - opt->readaddr) % BIN_BLOCK != 0) {
+			break;
+		}
+		memcpy(d->data + (a - opt->readaddr), fr + 8, n);
+		d->got[(a - opt->readaddr) / BIN_BLOCK] = 1;
+		break;
+	}
+
+	case ST_READ_IDLE:
+		read_next(d);
+		break;
+
+	case ST_END:
+		if (len < 0) {
+			fail(d, -3, "Nothing read while sending end of transmission!");
+			break;
+		}
+		if (opt->verbose) {
+			printf("Write '%c'  OK\n", opt->jump ? 'J' : '#');
+		}
+		d->status = 0;
+		d->state = ST_DONE;
+		d->end = now();
+		if (opt->stats) {
+			stats_t *st = &d->stats;
+			double t = d->end - d->start;
+			unsigned long bytes = opt->readlen > 0 ? st->rxbytes : st->txbytes;
+			printf("%s: %lu bytes in %lu records/frames, %.2f s, %.0f bytes/s, %.0f records/s\n",
+			       d->name, bytes, st->records, t, bytes / t, st->records / t);
+			printf("%s: %lu writes, %lu bytes in %lu reads, %.2f s waiting for replies\n",
+			       d->name, st->writes, st->rxbytes, st->reads, st->waiting);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+/* Handle the received bytes, a complete reply is passed to step() */
+void rx_handle(device_t *d)
+{
+	while (d->inpos < d->inlen && d->state < ST_DONE) {
+		int c = d->in[d->inpos++];
+
+		if (d->rxneed < 0) {
+			continue;
+		}
+		if (d->rxlen + 1 >= d->rxsize) {
+			d->rxsize = d->rxsize ? d->rxsize * 2 : RX_BUFLEN;
+			d->rxbuf = realloc(d->rxbuf, d->rxsize);
+			if (d->rxbuf == NULL) {
+				printf("Out of memory\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+		d->rxbuf[d->rxlen++] = c;
+		if (d->rxneed > 0 ? d->rxlen == d->rxneed : c == '\n' || d->rxlen == RX_MAXLINE) {
+			int len = d->rxlen;
+
+			d->rxbuf[len] = '\0';
+			d->rxlen = 0;
+			step(d, len);
+		}
+	}
+}
+
+/* Read in as many bytes as available */
+void rx_read(device_t *d)
+{
+	int n = read(d->fd, d->in, RX_BUFLEN);
+
+	if (n <= 0) {
+		if (n == 0 || (errno != EAGAIN && errno != EINTR)) {
+			printf("error %d reading %s: %s\n", errno, d->name, strerror(errno));
+			fail(d, -3, NULL);
+		}
+		return;
+	}
+	d->inpos = 0;
+	d->inlen = n;
+	d->stats.rxbytes += n;
+	d->stats.reads++;
+	/* The timeout is the time between two bytes */
+	if (d->state != ST_BAUD_WAIT) {
+		d->deadline = now() + timeout(d);
+	}
+	rx_handle(d);
+}
+
+/* Upload to all devices at the same time. Every device has its
+ * own protocol state, the event loop sends the queued data when
+ * a device accepts it and handles replies and timeouts as they
+ * come in. Returns when all devices are done or failed */
+void run(device_t *dev, int ndevices)
+{
+	struct pollfd pfd[MAX_DEVICES];
+
+	while (1) {
+		double t = now(), wake = -1, start;
+		int active = 0, ms;
+
+		for (int i = 0; i < ndevices; i++) {
+			device_t *d = &dev[i];
+
+			pfd[i].fd = -1;
+			pfd[i].events = 0;
+			pfd[i].revents = 0;
+			if (d->state >= ST_DONE) {
+				continue;
+			}
+			active++;
+			pfd[i].fd = d->fd;
+			pfd[i].events = POLLIN;
+			if (d->txpos < d->txlen) {
+				if (d->txnext <= t) {
+					pfd[i].events |= POLLOUT;
+				} else if (wake < 0 || d->txnext < wake) {
+					wake = d->txnext;
+				}
+			}
+			if (wake < 0 || d->deadline < wake) {
+				wake = d->deadline;
+			}
+		}
+		if (active == 0) {
+			break;
+		}
+
+		ms = wake <= t ? 0 : (int) ((wake - t) * 1000) + 1;
+		start = now();
+		if (poll(pfd, ndevices, ms) < 0 && errno != EINTR) {
+			perror("poll");
+			exit(EXIT_FAILURE);
+		}
+		t = now();
+
+		for (int i = 0; i < ndevices; i++) {
+			device_t *d = &dev[i];
+			int queued = 0;
+
+			if (d->state >= ST_DONE) {
+				continue;
+			}
+			if (d->txpos == d->txlen) {
+				d->stats.waiting += t - start;
+			}
+			if (pfd[i].revents & POLLOUT) {
+				tx_write(d);
+			}
+			if (d->state < ST_DONE && (pfd[i].revents & (POLLIN | POLLHUP | POLLERR))) {
+				rx_read(d);
+			}
+			if (d->state >= ST_DONE || now() < d->deadline) {
+				continue;
+			}
+			/* A reply cannot come before the data is on the line */
+			ioctl(d->fd, TIOCOUTQ, &queued);
+			if (d->state != ST_BAUD_WAIT && (d->txpos < d->txlen || queued > 0)) {
+				d->deadline = now() + timeout(d);
+			} else {
+				d->rxlen = 0;
+				step(d, -1);
+			}
+		}
+	}
+}
+
+/* Open the device and send the ! to start uploading */
+void dev_open(device_t *d, const char *portname, image_t *img, options_t *opt)
+{
+	memset(d, 0, sizeof *d);
+	d->name = portname;
+	d->img = img;
+	d->opt = opt;
+	d->start = now();
+
+	if (opt->verbose) {
+		printf("Serial port is: %s\n", portname);
+	}
+
+	/* Open the device */
+	d->fd = open(portname, O_RDWR | O_NOCTTY | O_NONBLOCK);
+
+	/* Check if device is open */
+	if (d->fd < 0) {
+		printf("error %d opening %s: %s\n", errno, portname, strerror (errno));
+		fail(d, -1, NULL);
+		return;
+	}
+
+	/* Set transmission parameters, reads do not block */
+	set_interface_attribs(d->fd, B9600, 0);
+	set_blocking(d->fd, 0, 0);
+	d->rate = 9600;
+
+	tx_puts(d, "!");
+	d->state = ST_HELLO;
+	expect(d, 0);
+}
+
+void dev_close(device_t *d)
+{
+	if (d->fd >= 0) {
+		close(d->fd);
+	}
+	for (int s = 0; s < MAX_SEGMENTS; s++) {
+		free(d->same[s]);
+	}
+	free(d->frames);
+	free(d->txbuf);
+	free(d->rxbuf);
+	free(d->data);
+	free(d->got);
+}
+
+int main(int argc, char *argv[]) {
+
+	/* The serial ports */
+	char *devices[MAX_DEVICES];
+	static device_t dev[MAX_DEVICES];
+	int ndevices = 0;
+	int failed;
+	double start;
+	/* Buffer for the file magic */
+	char line[SELFMAG];
+	int n;
+	char *end;
+
+	/* Input file */
+	FILE *fin = NULL;
+	/* The program image */
+	static image_t img;
+
+	/* Options */
+	int c;
+	options_t opt = { .timeout = 10, .maxbaud = BAUD_DEFAULT };
+	static const struct option longopts[] = {
+		{ "delta", no_argument, NULL, 'D' },
+		{ "stats", no_argument, NULL, 'S' },
+		{ "read", required_argument, NULL, 'R' },
+		{ "hwload", no_argument, NULL, 'H' },
+		{ NULL, 0, NULL, 0 }
+	};
+
+	/* Check for 0 extra arguments */
+	if (argc == 1) {
+		printf("upload -v -d <device> -t <timeout> filename\n");
+		printf("Upload S-record or ELF file to THUAS RISC-V processor\n");
+		printf("-v           -- verbose\n");
+		printf("-q           -- quiet, only errors\n");
+		printf("-j           -- run application after upload\n");
+		printf("-a           -- use S-records only, no binary transfer\n");
+		printf("-w <window>  -- maximum number of binary frames in flight\n");
+		printf("-z           -- compress binary frames\n");
+		printf("-V           -- verify the upload with a CRC32 on the target\n");
+		printf("--delta      -- only send blocks that differ from the target\n");
+		printf("--stats      -- print transfer statistics\n");
+		printf("--hwload     -- let the hardware loader write the ROM\n");
+		printf("--read <addr>:<len> -- read back memory to the file, no upload\n");
+		printf("-b <baud>    -- maximum baud rate, 9600 disables negotiation\n");
+		printf("-d <device>  -- serial device, may be given more than once\n");
+		printf("-t <timeout> -- timeout in deci seconds\n");
+		printf("-s <sleep>   -- sleep micro seconds after each character\n");
+		exit(EXIT_SUCCESS);
+	}
+
+	/* Parse options */
+	while ((c = getopt_long(argc, argv, "vd:t:js:qaw:b:zV", longopts, NULL)) != -1) {
+	        switch (c) {
+	        case 'd':
+	            if (ndevices == MAX_DEVICES) {
+	                fprintf(stderr, "Too many devices\n");
+	                exit(EXIT_FAILURE);
+	            }
+	            devices[ndevices++] = optarg;
+	            break;
+	        case 'j':
+	            opt.jump = 1;
+	            break;
+	        case 'a':
+	            opt.ascii = 1;
+	            break;
+	        case 'w':
+	            opt.maxwindow = atoi(optarg);
+	            break;
+	        case 'b':
+	            opt.maxbaud = atoi(optarg);
+	            break;
+	        case 'z':
+	            opt.packed = 1;
+	            break;
+	        case 'D':
+	            opt.delta = 1;
+	            break;
+	        case 'S':
+	            opt.stats = 1;
+	            break;
+	        case 'H':
+	            opt.hwload = 1;
+	            break;
+	        case 'V':
+	            opt.verify = 1;
+	            break;
+	        case 'R':
+	            opt.readaddr = strtoul(optarg, &end, 0);
+	            opt.readlen = *end == ':' ? strtoul(end+1, NULL, 0) : 0;
+	            if (opt.readlen == 0) {
+	                fprintf(stderr, "Please supply --read <addr>:<len>\n");
+	                exit(EXIT_FAILURE);
+	            }
+	            break;
+	        case 'v':
+	            opt.verbose = 1;
+	        case 'q':
+	            opt.quiet = 1;
+	            break;
+		case 't':
+		    opt.timeout = atoi(optarg);
+		    if (opt.timeout < 0) {
+			    opt.timeout = 0;
+		    }
+		    break;
+		case 's':
+		    opt.slepe = atoi(optarg);
+		    if (opt.slepe < 0) {
+			    opt.slepe = 0;
+		    }
+		    break;
+	        default: /* '?' */
+		    fprintf(stderr, "Unknown option '%c'\n", c);
+	            exit(EXIT_FAILURE);
+	        }
+	}
+
+	if (optind >= argc) {
+	    fprintf(stderr, "Please supply an input filename\n");
+	    exit(EXIT_FAILURE);
+	}
+
+	crc32_init();
+
+	/* Read back memory of one device to the file */
+	if (opt.readlen > 0) {
+		if (ndevices > 1) {
+			fprintf(stderr, "Only one device can be read back\n");
+			exit(EXIT_FAILURE);
+		}
+		opt.readfile = argv[optind];
+	} else {
+		fin = fopen(argv[optind], "rb");
+		if (fin == NULL) {
+			fprintf(stderr, "Cannot open input file %s\n", argv[optind]);
+			exit (EXIT_FAILURE);
+		}
+
+		/* Read in the ELF file or the S-records */
+		if (fread(line, 1, SELFMAG, fin) == SELFMAG && memcmp(line, ELFMAG, SELFMAG) == 0) {
+			rewind(fin);
+			n = load_elf(fin, &img);
+		} else {
+			rewind(fin);
+			n = load_srec(fin, &img);
+		}
+		if (n < 0) {
+			fclose(fin);
+			exit(EXIT_FAILURE);
+		}
+		fclose(fin);
+	}
+
+	if (ndevices == 0) {
+		devices[ndevices++] = "/dev/ttyUSB0";
+	}
+
+	/* Progress characters of several devices would mix */
+	if (ndevices > 1 && !opt.verbose) {
+		opt.quiet = 1;
+	}
+
+	/* All devices share the image and are handled by one
+	 * event loop, the ! is sent to all devices at once */
+	start = now();
+	for (int i = 0; i < ndevices; i++) {
+		dev_open(&dev[i], devices[i], &img, &opt);
+	}
+	run(dev, ndevices);
+
+	for (int i = 0; i < ndevices; i++) {
+		dev_close(&dev[i]);
+	}
+	image_free(&img);
+
+	if (ndevices == 1) {
+		exit(dev[0].status);
+	}
+
+	/* Print the summary with the time each upload took */
+	failed = 0;
+	for (int i = 0; i < ndevices; i++) {
+		printf("%-20s %s", devices[i], dev[i].status == 0 ? "OK    " : "FAILED");
+		printf(" %6.2f s\n", dev[i].end - start);
+		if (dev[i].status != 0) {
+			failed++;
+		}
+	}
 
-	/* Close devices */
-	close(fd);
-	fclose(fin);
+	return failed ? -3 : 0;
 }
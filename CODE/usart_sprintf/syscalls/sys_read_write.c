@@ -11,6 +11,10 @@
  * for __io_putchar and __io_getchar. By default, these
  * functions do nothing and return 0. */
 
+/* Buffered by libusart, see usart_setmode() */
+extern int usart_syswrite(const void *buf, int len) __attribute__((weak));
+extern int usart_sysread(void *buf, int len) __attribute__((weak));
+
 /* User callable functions */
 __attribute__((weak)) int __io_putchar(int ch) {
 	return 0;
@@ -22,6 +26,14 @@ __attribute__((weak)) int __io_getchar(void) {
 
 int _write(int fd, char* buf, int n) {
 
+	if (usart_syswrite) {
+		n = usart_syswrite(buf, n);
+		if (n < 0) {
+			errno = EAGAIN;
+		}
+		return n;
+	}
+
 	for (int i = 0; i < n; i++) {
 		__io_putchar(*buf++);
 	}
@@ -30,6 +42,14 @@ int _write(int fd, char* buf, int n) {
 
 int _read(int fd, char *buf, int n) {
 
+	if (usart_sysread) {
+		n = usart_sysread(buf, n);
+		if (n < 0) {
+			errno = EAGAIN;
+		}
+		return n;
+	}
+
 	for (int i = 0; i < n; i++) {
 		*buf++ = __io_getchar();
 	}
@@ -48,744 +48,1862 @@ signal bootrom : bootloader_type := (
            2 => x"17810010",
            3 => x"130181ff",
            4 => x"97020000",
-           5 => x"9382c23c",
+           5 => x"93824255",
            6 => x"73905230",
-           7 => x"b7070020",
-           8 => x"37050020",
-           9 => x"93870700",
-          10 => x"13070500",
-          11 => x"13060000",
-          12 => x"63e4e700",
-          13 => x"3386e740",
-          14 => x"93050000",
-          15 => x"13050500",
-          16 => x"ef00403c",
-          17 => x"37050020",
-          18 => x"b7070020",
-          19 => x"93870700",
-          20 => x"13070500",
-          21 => x"13060000",
-          22 => x"63e4e700",
-          23 => x"3386e740",
-          24 => x"b7150010",
-          25 => x"938505b9",
-          26 => x"13050500",
-          27 => x"ef004037",
-          28 => x"ef00003d",
-          29 => x"6f000000",
-          30 => x"37170000",
-          31 => x"b70700f0",
-          32 => x"13077745",
-          33 => x"23a2e702",
-          34 => x"67800000",
-          35 => x"1375f50f",
-          36 => x"b70700f0",
-          37 => x"23a0a702",
-          38 => x"370700f0",
-          39 => x"8327c702",
-          40 => x"93f70701",
-          41 => x"e38c07fe",
-          42 => x"67800000",
-          43 => x"130101ff",
-          44 => x"23248100",
-          45 => x"23261100",
-          46 => x"13040500",
-          47 => x"03450400",
-          48 => x"631a0500",
-          49 => x"8320c100",
-          50 => x"03248100",
-          51 => x"13010101",
-          52 => x"67800000",
-          53 => x"13041400",
-          54 => x"eff05ffb",
-          55 => x"6ff01ffe",
-          56 => x"63040500",
-          57 => x"6ff09ffc",
-          58 => x"67800000",
-          59 => x"b70600f0",
-          60 => x"83a7c602",
-          61 => x"93f74700",
-          62 => x"e38c07fe",
-          63 => x"03a50602",
-          64 => x"1375f50f",
-          65 => x"67800000",
-          66 => x"b70700f0",
-          67 => x"03a5c702",
-          68 => x"13754500",
-          69 => x"67800000",
-          70 => x"130101fd",
-          71 => x"23248102",
-          72 => x"23229102",
-          73 => x"23202103",
-          74 => x"232e3101",
-          75 => x"232c4101",
-          76 => x"232a5101",
-          77 => x"23286101",
-          78 => x"23267101",
-          79 => x"23248101",
-          80 => x"23229101",
-          81 => x"23261102",
-          82 => x"93040500",
-          83 => x"13040000",
-          84 => x"9309d000",
-          85 => x"1389f5ff",
-          86 => x"130ae005",
-          87 => x"930a5001",
-          88 => x"130b8000",
-          89 => x"930ba000",
-          90 => x"130c3000",
-          91 => x"b71c0010",
-          92 => x"eff0dff7",
-          93 => x"93070500",
-          94 => x"1375f50f",
-          95 => x"63043509",
-          96 => x"63cca902",
-          97 => x"63006505",
-          98 => x"630e7507",
-          99 => x"63008507",
-         100 => x"63562407",
-         101 => x"93f7f70f",
-         102 => x"138707fe",
-         103 => x"1377f70f",
-         104 => x"e368eafc",
-         105 => x"33878400",
-         106 => x"2300f700",
-         107 => x"13041400",
-         108 => x"eff0dfed",
-         109 => x"6ff0dffb",
-         110 => x"63065503",
-         111 => x"1307f007",
-         112 => x"e318e5fc",
-         113 => x"630c0402",
-         114 => x"1305f007",
-         115 => x"eff01fec",
-         116 => x"1304f4ff",
-         117 => x"6ff0dff9",
-         118 => x"1305f007",
-         119 => x"eff01feb",
-         120 => x"1304f4ff",
-         121 => x"e31a04fe",
-         122 => x"6ff09ff8",
-         123 => x"13850ca8",
-         124 => x"eff0dfeb",
-         125 => x"13040000",
-         126 => x"6ff09ff7",
-         127 => x"13057000",
-         128 => x"6ff01ffb",
-         129 => x"b3848400",
-         130 => x"37150010",
-         131 => x"23800400",
-         132 => x"13058595",
-         133 => x"eff09fe9",
-         134 => x"8320c102",
-         135 => x"13050400",
-         136 => x"03248102",
-         137 => x"83244102",
-         138 => x"03290102",
-         139 => x"8329c101",
-         140 => x"032a8101",
-         141 => x"832a4101",
-         142 => x"032b0101",
-         143 => x"832bc100",
-         144 => x"032c8100",
-         145 => x"832c4100",
-         146 => x"13010103",
-         147 => x"67800000",
-         148 => x"37180010",
-         149 => x"93070500",
-         150 => x"1308d8a8",
-         151 => x"03c70700",
-         152 => x"33070701",
-         153 => x"03470700",
-         154 => x"13778700",
-         155 => x"63160702",
-         156 => x"13050000",
-         157 => x"93081000",
-         158 => x"83c60700",
-         159 => x"3307d800",
-         160 => x"03470700",
-         161 => x"13764704",
-         162 => x"631c0600",
-         163 => x"63840500",
-         164 => x"23a0f500",
-         165 => x"67800000",
-         166 => x"93871700",
-         167 => x"6ff01ffc",
-         168 => x"13734700",
-         169 => x"13154500",
-         170 => x"13860600",
-         171 => x"630a0300",
-         172 => x"938606fd",
-         173 => x"33e5a600",
-         174 => x"93871700",
-         175 => x"6ff0dffb",
-         176 => x"13773700",
-         177 => x"63141701",
-         178 => x"13860602",
-         179 => x"130696fa",
-         180 => x"3365a600",
-         181 => x"6ff05ffe",
-         182 => x"130101fe",
-         183 => x"232e1100",
-         184 => x"23220100",
-         185 => x"23240100",
-         186 => x"23060100",
-         187 => x"9386f5ff",
-         188 => x"13077000",
-         189 => x"93070500",
-         190 => x"6374d700",
-         191 => x"93058000",
-         192 => x"13054100",
-         193 => x"b305b500",
-         194 => x"13069003",
-         195 => x"93f6f700",
-         196 => x"13870603",
-         197 => x"6374e600",
-         198 => x"13877605",
-         199 => x"a38fe5fe",
-         200 => x"9385f5ff",
-         201 => x"93d74700",
-         202 => x"e312b5fe",
-         203 => x"eff05fdb",
-         204 => x"8320c101",
-         205 => x"13010102",
-         206 => x"67800000",
-         207 => x"130101fe",
-         208 => x"23263101",
-         209 => x"b7190010",
-         210 => x"232c8100",
-         211 => x"232a9100",
-         212 => x"23282101",
-         213 => x"23244101",
-         214 => x"232e1100",
-         215 => x"93040500",
-         216 => x"13090000",
-         217 => x"13040000",
-         218 => x"9389d9a8",
-         219 => x"130a1000",
-         220 => x"63449902",
-         221 => x"8320c101",
-         222 => x"13050400",
-         223 => x"03248101",
-         224 => x"83244101",
-         225 => x"03290101",
-         226 => x"8329c100",
-         227 => x"032a8100",
-         228 => x"13010102",
-         229 => x"67800000",
-         230 => x"eff05fd5",
-         231 => x"b3073501",
-         232 => x"83c70700",
-         233 => x"13144400",
-         234 => x"13f74700",
-         235 => x"630a0700",
-         236 => x"930705fd",
-         237 => x"3364f400",
-         238 => x"13091900",
-         239 => x"6ff05ffb",
-         240 => x"13f74704",
-         241 => x"e30a07fe",
-         242 => x"93f73700",
-         243 => x"63944701",
-         244 => x"13050502",
-         245 => x"930795fa",
-         246 => x"6ff0dffd",
-         247 => x"6f000000",
-         248 => x"13030500",
-         249 => x"630e0600",
-         250 => x"83830500",
-         251 => x"23007300",
-         252 => x"1306f6ff",
-         253 => x"13031300",
-         254 => x"93851500",
-         255 => x"e31606fe",
-         256 => x"67800000",
-         257 => x"13030500",
-         258 => x"630a0600",
-         259 => x"2300b300",
-         260 => x"1306f6ff",
-         261 => x"13031300",
-         262 => x"e31a06fe",
-         263 => x"67800000",
-         264 => x"03460500",
-         265 => x"83c60500",
-         266 => x"13051500",
-         267 => x"93851500",
-         268 => x"6314d600",
-         269 => x"e31606fe",
-         270 => x"3305d640",
-         271 => x"67800000",
-         272 => x"130101f9",
-         273 => x"23261106",
-         274 => x"23248106",
-         275 => x"23229106",
-         276 => x"23202107",
-         277 => x"232e3105",
-         278 => x"232c4105",
-         279 => x"232a5105",
-         280 => x"23286105",
-         281 => x"23267105",
-         282 => x"23248105",
-         283 => x"23229105",
-         284 => x"2320a105",
-         285 => x"232eb103",
-         286 => x"eff01fc0",
-         287 => x"37150010",
-         288 => x"13050593",
-         289 => x"eff0dfc5",
-         290 => x"b70700f0",
-         291 => x"1307f03f",
-         292 => x"b704a000",
-         293 => x"37091000",
-         294 => x"23a2e700",
-         295 => x"13041000",
-         296 => x"93841400",
-         297 => x"1309f9ff",
-         298 => x"b70900f0",
-         299 => x"eff0dfc5",
-         300 => x"631c050e",
-         301 => x"13041400",
-         302 => x"6318940c",
-         303 => x"b70700f0",
-         304 => x"23a20700",
-         305 => x"63160500",
-         306 => x"23a20702",
-         307 => x"e7000500",
-         308 => x"eff0dfc1",
-         309 => x"93071002",
-         310 => x"93040000",
-         311 => x"6310f51e",
-         312 => x"b71a0010",
-         313 => x"13854a95",
-         314 => x"370901ff",
-         315 => x"b7090001",
-         316 => x"370affff",
-         317 => x"eff0dfbe",
-         318 => x"1309f9ff",
-         319 => x"9389f9ff",
-         320 => x"130afa0f",
-         321 => x"370400f0",
-         322 => x"83274400",
-         323 => x"93c71700",
-         324 => x"2322f400",
-         325 => x"eff09fbd",
-         326 => x"1375f50f",
-         327 => x"93073005",
-         328 => x"631ef516",
-         329 => x"eff09fbc",
-         330 => x"1374f50f",
-         331 => x"9307f4fc",
-         332 => x"93f7f70f",
-         333 => x"13072000",
-         334 => x"6362f710",
-         335 => x"93071003",
-         336 => x"6318f406",
-         337 => x"13052000",
-         338 => x"eff05fdf",
-         339 => x"130bd5ff",
-         340 => x"13054000",
-         341 => x"eff09fde",
-         342 => x"13040500",
-         343 => x"330bab00",
-         344 => x"130c3000",
-         345 => x"930c1000",
-         346 => x"631a6407",
-         347 => x"1304a000",
-         348 => x"eff0dfb7",
-         349 => x"1375f50f",
-         350 => x"e31c85fe",
-         351 => x"13854a95",
-         352 => x"eff01fb6",
-         353 => x"6ff01ff8",
-         354 => x"b3772401",
-         355 => x"e39007f2",
-         356 => x"1305a002",
-         357 => x"eff09faf",
-         358 => x"83a74900",
-         359 => x"93d71700",
-         360 => x"23a2f900",
-         361 => x"6ff09ff0",
-         362 => x"13051000",
-         363 => x"6ff01ff1",
-         364 => x"93072003",
-         365 => x"13052000",
-         366 => x"631af400",
-         367 => x"eff01fd8",
-         368 => x"130bc5ff",
-         369 => x"13056000",
-         370 => x"6ff0dff8",
-         371 => x"eff01fd7",
-         372 => x"130bb5ff",
-         373 => x"13058000",
-         374 => x"6ff0dff7",
-         375 => x"13052000",
-         376 => x"eff0dfd5",
-         377 => x"937bc4ff",
-         378 => x"93763400",
-         379 => x"13062000",
-         380 => x"03a70b00",
-         381 => x"93070500",
-         382 => x"6386c602",
-         383 => x"638a8603",
-         384 => x"638c9601",
-         385 => x"137707f0",
-         386 => x"b3e7e700",
-         387 => x"23a0fb00",
-         388 => x"13041400",
-         389 => x"6ff05ff5",
-         390 => x"33774701",
-         391 => x"93178500",
-         392 => x"6ff09ffe",
-         393 => x"33772701",
-         394 => x"93170501",
-         395 => x"6ff0dffd",
-         396 => x"33773701",
-         397 => x"93178501",
-         398 => x"6ff01ffd",
-         399 => x"930794fc",
-         400 => x"93f7f70f",
-         401 => x"130ba000",
-         402 => x"6362f704",
-         403 => x"13052000",
-         404 => x"eff0dfce",
-         405 => x"93077003",
-         406 => x"13058000",
-         407 => x"630af400",
-         408 => x"93078003",
-         409 => x"13056000",
-         410 => x"6304f400",
-         411 => x"13054000",
-         412 => x"eff0dfcc",
-         413 => x"93040500",
-         414 => x"1304a000",
-         415 => x"eff01fa7",
-         416 => x"1375f50f",
-         417 => x"e31c85fe",
-         418 => x"6ff05fef",
-         419 => x"eff01fa6",
-         420 => x"1375f50f",
-         421 => x"e31c65ff",
-         422 => x"6ff05fee",
-         423 => x"9307a004",
-         424 => x"6310f508",
-         425 => x"23220402",
-         426 => x"23220400",
-         427 => x"e7800400",
-         428 => x"b70700f0",
-         429 => x"1307a00a",
-         430 => x"23a2e700",
-         431 => x"37190010",
-         432 => x"13058995",
-         433 => x"b7190010",
-         434 => x"eff09fa1",
-         435 => x"13040000",
-         436 => x"b71b0010",
-         437 => x"9389d9a8",
-         438 => x"b7170010",
-         439 => x"1385c795",
-         440 => x"eff01fa0",
-         441 => x"93059002",
-         442 => x"13054100",
-         443 => x"eff0dfa2",
-         444 => x"13054100",
-         445 => x"ef00401e",
-         446 => x"b7170010",
-         447 => x"130a0500",
-         448 => x"93850796",
-         449 => x"13054100",
-         450 => x"eff09fd1",
-         451 => x"63100502",
-         452 => x"37150010",
-         453 => x"13054596",
-         454 => x"eff09f9c",
-         455 => x"6f004003",
-         456 => x"93073002",
-         457 => x"e31cf5e4",
-         458 => x"6ff09ff8",
-         459 => x"b7170010",
-         460 => x"9385c7a4",
-         461 => x"13054100",
-         462 => x"eff09fce",
-         463 => x"63100502",
-         464 => x"b70700f0",
-         465 => x"23a20702",
-         466 => x"23a20700",
-         467 => x"e7800400",
-         468 => x"13058995",
-         469 => x"eff0df98",
-         470 => x"6ff01ff8",
-         471 => x"b7170010",
-         472 => x"13063000",
-         473 => x"938507a5",
-         474 => x"13054100",
-         475 => x"ef008018",
-         476 => x"63100504",
-         477 => x"93050000",
-         478 => x"13057100",
-         479 => x"eff05fad",
-         480 => x"93773500",
-         481 => x"13040500",
-         482 => x"639a0712",
-         483 => x"93058000",
-         484 => x"eff09fb4",
-         485 => x"37150010",
-         486 => x"130545a5",
-         487 => x"eff05f94",
-         488 => x"03250400",
-         489 => x"93058000",
-         490 => x"eff01fb3",
-         491 => x"6ff05ffa",
-         492 => x"b7170010",
-         493 => x"13063000",
-         494 => x"938507a7",
-         495 => x"13054100",
-         496 => x"ef004013",
-         497 => x"63180502",
-         498 => x"93050100",
-         499 => x"13057100",
-         500 => x"eff01fa8",
-         501 => x"93773500",
-         502 => x"13040500",
-         503 => x"6390070e",
-         504 => x"03250100",
-         505 => x"93050000",
-         506 => x"eff09fa6",
-         507 => x"2320a400",
-         508 => x"6ff01ff6",
-         509 => x"13063000",
-         510 => x"93854ba7",
-         511 => x"13054100",
-         512 => x"ef00400f",
-         513 => x"83474100",
-         514 => x"1307e006",
-         515 => x"63080508",
-         516 => x"639ce70a",
-         517 => x"93773400",
-         518 => x"6392070a",
-         519 => x"130c0404",
-         520 => x"b71c0010",
-         521 => x"371d0010",
-         522 => x"930d80ff",
-         523 => x"93058000",
-         524 => x"13050400",
-         525 => x"eff05faa",
-         526 => x"13854ca5",
-         527 => x"eff05f8a",
-         528 => x"032a0400",
-         529 => x"93058000",
-         530 => x"930a8001",
-         531 => x"13050a00",
-         532 => x"eff09fa8",
-         533 => x"13058da7",
-         534 => x"eff09f88",
-         535 => x"370b00ff",
-         536 => x"33756a01",
-         537 => x"33555501",
-         538 => x"b3063501",
-         539 => x"83c60600",
-         540 => x"93f67609",
-         541 => x"63800604",
-         542 => x"938a8aff",
-         543 => x"eff01f81",
-         544 => x"135b8b00",
-         545 => x"e39ebafd",
-         546 => x"13044400",
-         547 => x"13058995",
-         548 => x"eff01f85",
-         549 => x"e31c8cf8",
-         550 => x"6ff09feb",
-         551 => x"e38ce7f6",
-         552 => x"93050000",
-         553 => x"13057100",
-         554 => x"eff09f9a",
-         555 => x"13040500",
-         556 => x"6ff05ff6",
-         557 => x"1305e002",
-         558 => x"6ff01ffc",
-         559 => x"37150010",
-         560 => x"130585a5",
-         561 => x"6ff05fe5",
-         562 => x"e3040ae8",
-         563 => x"37150010",
-         564 => x"1305c5a7",
-         565 => x"6ff05fe4",
-         566 => x"93070500",
-         567 => x"03c70700",
-         568 => x"93871700",
-         569 => x"e31c07fe",
-         570 => x"3385a740",
-         571 => x"1305f5ff",
-         572 => x"67800000",
-         573 => x"630a0602",
-         574 => x"1306f6ff",
-         575 => x"13070000",
-         576 => x"b307e500",
-         577 => x"b386e500",
-         578 => x"83c70700",
-         579 => x"83c60600",
-         580 => x"6398d700",
-         581 => x"6306c700",
-         582 => x"13071700",
-         583 => x"e39207fe",
-         584 => x"3385d740",
-         585 => x"67800000",
-         586 => x"13050000",
-         587 => x"67800000",
-         588 => x"0d0a5448",
-         589 => x"55415320",
-         590 => x"52495343",
-         591 => x"2d562042",
-         592 => x"6f6f746c",
-         593 => x"6f616465",
-         594 => x"72207630",
-         595 => x"2e310d0a",
-         596 => x"00000000",
-         597 => x"3f0a0000",
-         598 => x"0d0a0000",
-         599 => x"3e200000",
-         600 => x"68000000",
-         601 => x"48656c70",
-         602 => x"3a0d0a20",
-         603 => x"68202020",
-         604 => x"20202020",
-         605 => x"20202020",
-         606 => x"20202020",
-         607 => x"202d2074",
-         608 => x"68697320",
-         609 => x"68656c70",
-         610 => x"0d0a2072",
-         611 => x"20202020",
-         612 => x"20202020",
-         613 => x"20202020",
-         614 => x"20202020",
-         615 => x"2d207275",
-         616 => x"6e206170",
-         617 => x"706c6963",
-         618 => x"6174696f",
-         619 => x"6e0d0a20",
-         620 => x"7277203c",
-         621 => x"61646472",
-         622 => x"3e202020",
-         623 => x"20202020",
-         624 => x"202d2072",
-         625 => x"65616420",
-         626 => x"776f7264",
-         627 => x"2066726f",
-         628 => x"6d206164",
-         629 => x"64720d0a",
-         630 => x"20777720",
-         631 => x"3c616464",
-         632 => x"723e203c",
-         633 => x"64617461",
-         634 => x"3e202d20",
-         635 => x"77726974",
-         636 => x"65206461",
-         637 => x"74612061",
-         638 => x"74206164",
-         639 => x"64720d0a",
-         640 => x"20647720",
-         641 => x"3c616464",
-         642 => x"723e2020",
-         643 => x"20202020",
-         644 => x"20202d20",
-         645 => x"64756d70",
-         646 => x"20313620",
-         647 => x"776f7264",
-         648 => x"730d0a20",
-         649 => x"6e202020",
-         650 => x"20202020",
-         651 => x"20202020",
-         652 => x"20202020",
-         653 => x"202d2064",
-         654 => x"756d7020",
-         655 => x"6e657874",
-         656 => x"20313620",
-         657 => x"776f7264",
-         658 => x"73000000",
-         659 => x"72000000",
-         660 => x"72772000",
-         661 => x"3a200000",
-         662 => x"4e6f7420",
-         663 => x"6f6e2034",
-         664 => x"2d627974",
-         665 => x"6520626f",
-         666 => x"756e6461",
-         667 => x"72792100",
-         668 => x"77772000",
-         669 => x"64772000",
-         670 => x"20200000",
-         671 => x"3f3f0000",
-         672 => x"3c627265",
-         673 => x"616b3e0d",
-         674 => x"0a000000",
-         675 => x"00202020",
-         676 => x"20202020",
-         677 => x"20202828",
-         678 => x"28282820",
-         679 => x"20202020",
-         680 => x"20202020",
-         681 => x"20202020",
-         682 => x"20202020",
-         683 => x"20881010",
-         684 => x"10101010",
-         685 => x"10101010",
-         686 => x"10101010",
-         687 => x"10040404",
-         688 => x"04040404",
-         689 => x"04040410",
-         690 => x"10101010",
-         691 => x"10104141",
-         692 => x"41414141",
-         693 => x"01010101",
-         694 => x"01010101",
-         695 => x"01010101",
-         696 => x"01010101",
-         697 => x"01010101",
-         698 => x"10101010",
-         699 => x"10104242",
-         700 => x"42424242",
-         701 => x"02020202",
-         702 => x"02020202",
-         703 => x"02020202",
-         704 => x"02020202",
-         705 => x"02020202",
-         706 => x"10101010",
-         707 => x"20000000",
-         708 => x"00000000",
-         709 => x"00000000",
-         710 => x"00000000",
-         711 => x"00000000",
-         712 => x"00000000",
-         713 => x"00000000",
-         714 => x"00000000",
-         715 => x"00000000",
-         716 => x"00000000",
-         717 => x"00000000",
-         718 => x"00000000",
-         719 => x"00000000",
-         720 => x"00000000",
-         721 => x"00000000",
-         722 => x"00000000",
-         723 => x"00000000",
-         724 => x"00000000",
-         725 => x"00000000",
-         726 => x"00000000",
-         727 => x"00000000",
-         728 => x"00000000",
-         729 => x"00000000",
-         730 => x"00000000",
-         731 => x"00000000",
-         732 => x"00000000",
-         733 => x"00000000",
-         734 => x"00000000",
-         735 => x"00000000",
-         736 => x"00000000",
-         737 => x"00000000",
-         738 => x"00000000",
-         739 => x"00000000",
+           7 => x"6f004000",
+           8 => x"130101ff",
+           9 => x"23261100",
+          10 => x"37150020",
+          11 => x"13050592",
+          12 => x"b7050020",
+          13 => x"93850500",
+          14 => x"63f8a500",
+          15 => x"23800500",
+          16 => x"93851500",
+          17 => x"e3eca5fe",
+          18 => x"37050020",
+          19 => x"13050500",
+          20 => x"b7050020",
+          21 => x"93850500",
+          22 => x"63f0a502",
+          23 => x"37260010",
+          24 => x"130686cf",
+          25 => x"83060600",
+          26 => x"2380d500",
+          27 => x"93851500",
+          28 => x"13061600",
+          29 => x"e3e8a5fe",
+          30 => x"97000000",
+          31 => x"e780004f",
+          32 => x"6f000000",
+          33 => x"130101fc",
+          34 => x"232e1102",
+          35 => x"232c8102",
+          36 => x"232a9102",
+          37 => x"23282103",
+          38 => x"23263103",
+          39 => x"23244103",
+          40 => x"23225103",
+          41 => x"23206103",
+          42 => x"232e7101",
+          43 => x"232c8101",
+          44 => x"232a9101",
+          45 => x"2328a101",
+          46 => x"2326b101",
+          47 => x"2322a100",
+          48 => x"370a00f0",
+          49 => x"b70a0020",
+          50 => x"37850100",
+          51 => x"1304056a",
+          52 => x"130c2000",
+          53 => x"93844a01",
+          54 => x"13858400",
+          55 => x"2324a100",
+          56 => x"930ca005",
+          57 => x"930d7000",
+          58 => x"130d0010",
+          59 => x"13093000",
+          60 => x"03254a00",
+          61 => x"13451500",
+          62 => x"2322aa00",
+          63 => x"97100000",
+          64 => x"e7800012",
+          65 => x"130b0000",
+          66 => x"238aaa00",
+          67 => x"930b1000",
+          68 => x"93098000",
+          69 => x"13050400",
+          70 => x"97100000",
+          71 => x"e7804014",
+          72 => x"63480504",
+          73 => x"b3859b00",
+          74 => x"2380a500",
+          75 => x"6396bb03",
+          76 => x"03c53400",
+          77 => x"83c52400",
+          78 => x"13158500",
+          79 => x"336bb500",
+          80 => x"63686d03",
+          81 => x"03c54a01",
+          82 => x"9305d5fb",
+          83 => x"63e42501",
+          84 => x"63109503",
+          85 => x"b3093b01",
+          86 => x"938b1b00",
+          87 => x"13854900",
+          88 => x"e3eaabfa",
+          89 => x"97100000",
+          90 => x"e7800005",
+          91 => x"630c0502",
+          92 => x"13050400",
+          93 => x"97100000",
+          94 => x"e780800e",
+          95 => x"e35a05fe",
+          96 => x"130be0ff",
+          97 => x"63580b06",
+          98 => x"1305e004",
+          99 => x"97100000",
+         100 => x"e7808003",
+         101 => x"03c51400",
+         102 => x"97100000",
+         103 => x"e780c002",
+         104 => x"6ff01ff5",
+         105 => x"13050000",
+         106 => x"93850400",
+         107 => x"13860900",
+         108 => x"97100000",
+         109 => x"e78080d6",
+         110 => x"b3859900",
+         111 => x"03c61500",
+         112 => x"83c60500",
+         113 => x"03c72500",
+         114 => x"13168600",
+         115 => x"83853500",
+         116 => x"3366d600",
+         117 => x"93160701",
+         118 => x"3366d600",
+         119 => x"93958501",
+         120 => x"b365b600",
+         121 => x"e312b5fa",
+         122 => x"1305e0ff",
+         123 => x"e302abf8",
+         124 => x"6ff05ff9",
+         125 => x"83cb4a01",
+         126 => x"1385dbfb",
+         127 => x"6376850f",
+         128 => x"03c55400",
+         129 => x"83c54400",
+         130 => x"03c66400",
+         131 => x"13158500",
+         132 => x"83867400",
+         133 => x"3365b500",
+         134 => x"93150601",
+         135 => x"3365b500",
+         136 => x"93958601",
+         137 => x"3365b500",
+         138 => x"97100000",
+         139 => x"e780c06b",
+         140 => x"63020b0a",
+         141 => x"33856401",
+         142 => x"130b8500",
+         143 => x"032c8100",
+         144 => x"930cf007",
+         145 => x"13053004",
+         146 => x"639aab00",
+         147 => x"03050c00",
+         148 => x"937cf50f",
+         149 => x"63400504",
+         150 => x"130c1c00",
+         151 => x"63786c03",
+         152 => x"03450c00",
+         153 => x"93091c00",
+         154 => x"97100000",
+         155 => x"e7808069",
+         156 => x"33359001",
+         157 => x"b3b56901",
+         158 => x"3375b500",
+         159 => x"938cfcff",
+         160 => x"138c0900",
+         161 => x"e31e05fc",
+         162 => x"6f004004",
+         163 => x"93090c00",
+         164 => x"6f00c003",
+         165 => x"03452c00",
+         166 => x"83451c00",
+         167 => x"13158500",
+         168 => x"b369b500",
+         169 => x"13f5fc07",
+         170 => x"930c3500",
+         171 => x"13850900",
+         172 => x"97100000",
+         173 => x"e780c069",
+         174 => x"97100000",
+         175 => x"e7808064",
+         176 => x"938cfcff",
+         177 => x"e3940cfe",
+         178 => x"93093c00",
+         179 => x"138c0900",
+         180 => x"e3e869f7",
+         181 => x"97100000",
+         182 => x"e780006b",
+         183 => x"130c2000",
+         184 => x"930ca005",
+         185 => x"6f008003",
+         186 => x"13055004",
+         187 => x"6398ab02",
+         188 => x"03c55400",
+         189 => x"83c54400",
+         190 => x"03c66400",
+         191 => x"13158500",
+         192 => x"83867400",
+         193 => x"3365b500",
+         194 => x"93150601",
+         195 => x"3365b500",
+         196 => x"93958601",
+         197 => x"3365b500",
+         198 => x"2322a100",
+         199 => x"13051004",
+         200 => x"97100000",
+         201 => x"e78040ea",
+         202 => x"03c51400",
+         203 => x"97100000",
+         204 => x"e78080e9",
+         205 => x"03c54a01",
+         206 => x"e31c95db",
+         207 => x"03254100",
+         208 => x"8320c103",
+         209 => x"03248103",
+         210 => x"83244103",
+         211 => x"03290103",
+         212 => x"8329c102",
+         213 => x"032a8102",
+         214 => x"832a4102",
+         215 => x"032b0102",
+         216 => x"832bc101",
+         217 => x"032c8101",
+         218 => x"832c4101",
+         219 => x"032d0101",
+         220 => x"832dc100",
+         221 => x"13010104",
+         222 => x"67800000",
+         223 => x"130101fe",
+         224 => x"232e1100",
+         225 => x"232c8100",
+         226 => x"232a9100",
+         227 => x"23282101",
+         228 => x"23263101",
+         229 => x"23244101",
+         230 => x"13040500",
+         231 => x"638e0504",
+         232 => x"93840500",
+         233 => x"93050000",
+         234 => x"370a00f0",
+         235 => x"03254a00",
+         236 => x"13451500",
+         237 => x"13060010",
+         238 => x"2322aa00",
+         239 => x"93890400",
+         240 => x"63e4c400",
+         241 => x"93090010",
+         242 => x"13891500",
+         243 => x"13054004",
+         244 => x"13060400",
+         245 => x"93060400",
+         246 => x"13870900",
+         247 => x"97000000",
+         248 => x"e7800007",
+         249 => x"b3843441",
+         250 => x"33848900",
+         251 => x"93050900",
+         252 => x"e39e04fa",
+         253 => x"6f008000",
+         254 => x"13090000",
+         255 => x"37050020",
+         256 => x"93064501",
+         257 => x"1305a005",
+         258 => x"93050900",
+         259 => x"13060400",
+         260 => x"13070000",
+         261 => x"97000000",
+         262 => x"e7808003",
+         263 => x"370500f0",
+         264 => x"8325c502",
+         265 => x"93f50501",
+         266 => x"e38c05fe",
+         267 => x"8320c101",
+         268 => x"03248101",
+         269 => x"83244101",
+         270 => x"03290101",
+         271 => x"8329c100",
+         272 => x"032a8100",
+         273 => x"13010102",
+         274 => x"67800000",
+         275 => x"130101fe",
+         276 => x"232e1100",
+         277 => x"232c8100",
+         278 => x"232a9100",
+         279 => x"23282101",
+         280 => x"23263101",
+         281 => x"13040700",
+         282 => x"93840600",
+         283 => x"b7060020",
+         284 => x"238aa600",
+         285 => x"13894601",
+         286 => x"a300b900",
+         287 => x"2301e900",
+         288 => x"13558700",
+         289 => x"a301a900",
+         290 => x"2302c900",
+         291 => x"13558600",
+         292 => x"a302a900",
+         293 => x"13550601",
+         294 => x"2303a900",
+         295 => x"13558601",
+         296 => x"a303a900",
+         297 => x"13068000",
+         298 => x"93098000",
+         299 => x"13050000",
+         300 => x"93050900",
+         301 => x"97100000",
+         302 => x"e78040a6",
+         303 => x"93050000",
+         304 => x"370600f0",
+         305 => x"b3862501",
+         306 => x"83c60600",
+         307 => x"0327c602",
+         308 => x"13770701",
+         309 => x"e30c07fe",
+         310 => x"93851500",
+         311 => x"2320d602",
+         312 => x"e39235ff",
+         313 => x"630c0402",
+         314 => x"13090000",
+         315 => x"b70900f0",
+         316 => x"b3852401",
+         317 => x"03c60500",
+         318 => x"83a6c902",
+         319 => x"93f60601",
+         320 => x"e38c06fe",
+         321 => x"23a0c902",
+         322 => x"13061000",
+         323 => x"97100000",
+         324 => x"e780c0a0",
+         325 => x"13091900",
+         326 => x"e31c89fc",
+         327 => x"93050000",
+         328 => x"370600f0",
+         329 => x"93064000",
+         330 => x"13973500",
+         331 => x"8327c602",
+         332 => x"93f70701",
+         333 => x"e38c07fe",
+         334 => x"3357e500",
+         335 => x"93851500",
+         336 => x"2320e602",
+         337 => x"e392d5fe",
+         338 => x"8320c101",
+         339 => x"03248101",
+         340 => x"83244101",
+         341 => x"03290101",
+         342 => x"8329c100",
+         343 => x"13010102",
+         344 => x"67800000",
+         345 => x"6f000000",
+         346 => x"130101f6",
+         347 => x"232e1108",
+         348 => x"232c8108",
+         349 => x"232a9108",
+         350 => x"23282109",
+         351 => x"23263109",
+         352 => x"23244109",
+         353 => x"23225109",
+         354 => x"23206109",
+         355 => x"232e7107",
+         356 => x"232c8107",
+         357 => x"232a9107",
+         358 => x"2328a107",
+         359 => x"2326b107",
+         360 => x"370500f0",
+         361 => x"03250500",
+         362 => x"13750520",
+         363 => x"e3100516",
+         364 => x"37850020",
+         365 => x"032505c0",
+         366 => x"b7554f42",
+         367 => x"938545f5",
+         368 => x"e306b514",
+         369 => x"97100000",
+         370 => x"e78040b8",
+         371 => x"37250010",
+         372 => x"130595ad",
+         373 => x"97100000",
+         374 => x"e78000c1",
+         375 => x"930a0000",
+         376 => x"370400f0",
+         377 => x"1305f03f",
+         378 => x"2322a400",
+         379 => x"8324040f",
+         380 => x"13099000",
+         381 => x"37a50700",
+         382 => x"93090512",
+         383 => x"130a4400",
+         384 => x"e34e590f",
+         385 => x"0325040f",
+         386 => x"33059540",
+         387 => x"138b1a00",
+         388 => x"b3053b03",
+         389 => x"6360b502",
+         390 => x"1305a002",
+         391 => x"97100000",
+         392 => x"e78080ba",
+         393 => x"03254400",
+         394 => x"13551500",
+         395 => x"2320aa00",
+         396 => x"930a0b00",
+         397 => x"97100000",
+         398 => x"e780c0f4",
+         399 => x"e30205fc",
+         400 => x"370500f0",
+         401 => x"23220500",
+         402 => x"97100000",
+         403 => x"e78040bd",
+         404 => x"93051002",
+         405 => x"13060000",
+         406 => x"23240102",
+         407 => x"631cb52e",
+         408 => x"37250010",
+         409 => x"1304e5a8",
+         410 => x"13050400",
+         411 => x"97100000",
+         412 => x"e78080b7",
+         413 => x"13050000",
+         414 => x"23240102",
+         415 => x"930cc000",
+         416 => x"37250010",
+         417 => x"9304d5af",
+         418 => x"37250010",
+         419 => x"930d85a5",
+         420 => x"37250010",
+         421 => x"130915a9",
+         422 => x"37250010",
+         423 => x"9309a5af",
+         424 => x"37250010",
+         425 => x"130af5b1",
+         426 => x"130da000",
+         427 => x"b70500f0",
+         428 => x"03a54500",
+         429 => x"13451500",
+         430 => x"23a2a500",
+         431 => x"97100000",
+         432 => x"e78000b6",
+         433 => x"1375f50f",
+         434 => x"930595fb",
+         435 => x"63eebc0e",
+         436 => x"13952500",
+         437 => x"3305b501",
+         438 => x"03250500",
+         439 => x"67000500",
+         440 => x"13050900",
+         441 => x"97100000",
+         442 => x"e78000b0",
+         443 => x"13058000",
+         444 => x"97100000",
+         445 => x"e7808018",
+         446 => x"930a0500",
+         447 => x"13058000",
+         448 => x"97100000",
+         449 => x"e7808017",
+         450 => x"93050500",
+         451 => x"13850a00",
+         452 => x"97000000",
+         453 => x"e780c0c6",
+         454 => x"6ff05ff9",
+         455 => x"13050a00",
+         456 => x"97100000",
+         457 => x"e78040ac",
+         458 => x"97100000",
+         459 => x"e78000b9",
+         460 => x"6ff0dff7",
+         461 => x"13850900",
+         462 => x"97100000",
+         463 => x"e780c0aa",
+         464 => x"13058000",
+         465 => x"97100000",
+         466 => x"e7804013",
+         467 => x"930a0500",
+         468 => x"13058000",
+         469 => x"97100000",
+         470 => x"e7804012",
+         471 => x"130b0500",
+         472 => x"13058000",
+         473 => x"97100000",
+         474 => x"e7804011",
+         475 => x"930b0500",
+         476 => x"3335a000",
+         477 => x"b3356001",
+         478 => x"33f5a500",
+         479 => x"630e0502",
+         480 => x"130c0b00",
+         481 => x"63647b01",
+         482 => x"138c0b00",
+         483 => x"13050000",
+         484 => x"93850a00",
+         485 => x"13060c00",
+         486 => x"97000000",
+         487 => x"e7800078",
+         488 => x"93058000",
+         489 => x"97100000",
+         490 => x"e7804004",
+         491 => x"330b8b41",
+         492 => x"b30a5c01",
+         493 => x"e3160bfc",
+         494 => x"13850400",
+         495 => x"97100000",
+         496 => x"e78080a2",
+         497 => x"6ff09fee",
+         498 => x"93053002",
+         499 => x"630ab512",
+         500 => x"93052004",
+         501 => x"6310b510",
+         502 => x"13052004",
+         503 => x"97100000",
+         504 => x"e780809e",
+         505 => x"13058000",
+         506 => x"93052000",
+         507 => x"97100000",
+         508 => x"e780c0ff",
+         509 => x"13850400",
+         510 => x"97100000",
+         511 => x"e780c09e",
+         512 => x"03258102",
+         513 => x"97000000",
+         514 => x"e7800088",
+         515 => x"2324a102",
+         516 => x"6ff0dfe9",
+         517 => x"03258102",
+         518 => x"97000000",
+         519 => x"e780c074",
+         520 => x"2324a102",
+         521 => x"6ff09fe8",
+         522 => x"97100000",
+         523 => x"e780409f",
+         524 => x"137bf50f",
+         525 => x"1305fbfc",
+         526 => x"93052000",
+         527 => x"63eea504",
+         528 => x"13052000",
+         529 => x"97100000",
+         530 => x"e7804003",
+         531 => x"33056541",
+         532 => x"930ae502",
+         533 => x"13151b00",
+         534 => x"130525fa",
+         535 => x"97100000",
+         536 => x"e780c001",
+         537 => x"97100000",
+         538 => x"e7800008",
+         539 => x"63800a02",
+         540 => x"13052000",
+         541 => x"97100000",
+         542 => x"e7804000",
+         543 => x"97100000",
+         544 => x"e7804008",
+         545 => x"938afaff",
+         546 => x"e3940afe",
+         547 => x"97100000",
+         548 => x"e780800f",
+         549 => x"6f000003",
+         550 => x"13059bfc",
+         551 => x"63e4a502",
+         552 => x"13052000",
+         553 => x"97100000",
+         554 => x"e78040fd",
+         555 => x"13151b00",
+         556 => x"93056007",
+         557 => x"3385a540",
+         558 => x"97100000",
+         559 => x"e78000fc",
+         560 => x"2324a102",
+         561 => x"97100000",
+         562 => x"e7808095",
+         563 => x"1375f50f",
+         564 => x"e31aa5ff",
+         565 => x"13050400",
+         566 => x"97100000",
+         567 => x"e780c090",
+         568 => x"6ff0dfdc",
+         569 => x"97100000",
+         570 => x"e780c08b",
+         571 => x"370500f0",
+         572 => x"23220500",
+         573 => x"03258102",
+         574 => x"e7000500",
+         575 => x"6f00c001",
+         576 => x"37250010",
+         577 => x"130595ac",
+         578 => x"97100000",
+         579 => x"e780c08d",
+         580 => x"97100000",
+         581 => x"e780c087",
+         582 => x"370500f0",
+         583 => x"9305a00a",
+         584 => x"2322b500",
+         585 => x"97100000",
+         586 => x"e7800089",
+         587 => x"6354a002",
+         588 => x"13040500",
+         589 => x"37250010",
+         590 => x"1305c5ac",
+         591 => x"97100000",
+         592 => x"e780808a",
+         593 => x"93058000",
+         594 => x"13050400",
+         595 => x"97100000",
+         596 => x"e780c0e9",
+         597 => x"37250010",
+         598 => x"930495ac",
+         599 => x"13850400",
+         600 => x"97100000",
+         601 => x"e7804088",
+         602 => x"13090000",
+         603 => x"37250010",
+         604 => x"130a25ac",
+         605 => x"37250010",
+         606 => x"930aa5b2",
+         607 => x"37250010",
+         608 => x"1305c5b2",
+         609 => x"2328a102",
+         610 => x"37250010",
+         611 => x"1305f5af",
+         612 => x"232ca102",
+         613 => x"37250010",
+         614 => x"130565aa",
+         615 => x"232aa102",
+         616 => x"37250010",
+         617 => x"930cc5b1",
+         618 => x"37250010",
+         619 => x"1305a5aa",
+         620 => x"2322a102",
+         621 => x"37250010",
+         622 => x"130545a9",
+         623 => x"2326a102",
+         624 => x"37250010",
+         625 => x"130585a9",
+         626 => x"2320a102",
+         627 => x"37250010",
+         628 => x"130415b0",
+         629 => x"930df005",
+         630 => x"130b80ff",
+         631 => x"37250010",
+         632 => x"130595cc",
+         633 => x"232ea100",
+         634 => x"37250010",
+         635 => x"130555ac",
+         636 => x"232ca100",
+         637 => x"37250010",
+         638 => x"130545b0",
+         639 => x"232aa100",
+         640 => x"37250010",
+         641 => x"130585b0",
+         642 => x"2326a100",
+         643 => x"37250010",
+         644 => x"1305e5b0",
+         645 => x"2322a100",
+         646 => x"37250010",
+         647 => x"1305c5a8",
+         648 => x"2320a100",
+         649 => x"37250010",
+         650 => x"130525b2",
+         651 => x"2328a100",
+         652 => x"37250010",
+         653 => x"130575b2",
+         654 => x"2324a100",
+         655 => x"13050a00",
+         656 => x"97000000",
+         657 => x"e780407a",
+         658 => x"13053104",
+         659 => x"93059002",
+         660 => x"97100000",
+         661 => x"e780c0b4",
+         662 => x"13053104",
+         663 => x"97100000",
+         664 => x"e780c0f6",
+         665 => x"93090500",
+         666 => x"13053104",
+         667 => x"93850a00",
+         668 => x"97100000",
+         669 => x"e78040f7",
+         670 => x"63040512",
+         671 => x"13053104",
+         672 => x"83258103",
+         673 => x"97100000",
+         674 => x"e78000f6",
+         675 => x"630e0510",
+         676 => x"13053104",
+         677 => x"13063000",
+         678 => x"83254103",
+         679 => x"97100000",
+         680 => x"e78040f8",
+         681 => x"63000512",
+         682 => x"13053104",
+         683 => x"13063000",
+         684 => x"8325c102",
+         685 => x"97100000",
+         686 => x"e780c0f6",
+         687 => x"630a0514",
+         688 => x"13053104",
+         689 => x"13063000",
+         690 => x"83250102",
+         691 => x"97100000",
+         692 => x"e78040f5",
+         693 => x"83453104",
+         694 => x"13351500",
+         695 => x"138625f9",
+         696 => x"13361600",
+         697 => x"3365c500",
+         698 => x"630e0514",
+         699 => x"1305e006",
+         700 => x"638ca500",
+         701 => x"13056104",
+         702 => x"93050000",
+         703 => x"97100000",
+         704 => x"e78000c9",
+         705 => x"13090500",
+         706 => x"13753900",
+         707 => x"63180526",
+         708 => x"130d0000",
+         709 => x"93058000",
+         710 => x"13050900",
+         711 => x"97100000",
+         712 => x"e780c0cc",
+         713 => x"13850c00",
+         714 => x"97000000",
+         715 => x"e780c06b",
+         716 => x"83290900",
+         717 => x"93058000",
+         718 => x"13850900",
+         719 => x"97100000",
+         720 => x"e780c0ca",
+         721 => x"13050400",
+         722 => x"97000000",
+         723 => x"e780c069",
+         724 => x"370c00ff",
+         725 => x"930b8001",
+         726 => x"33753c01",
+         727 => x"33557501",
+         728 => x"930505fe",
+         729 => x"63e4b501",
+         730 => x"1305e002",
+         731 => x"97000000",
+         732 => x"e7808065",
+         733 => x"938b8bff",
+         734 => x"135c8c00",
+         735 => x"e39e6bfd",
+         736 => x"13094900",
+         737 => x"13850400",
+         738 => x"97000000",
+         739 => x"e780c065",
+         740 => x"130d1d00",
+         741 => x"13050001",
+         742 => x"e31eadf6",
+         743 => x"6f00c01e",
+         744 => x"03250103",
+         745 => x"6f00c01d",
+         746 => x"97000000",
+         747 => x"e780805f",
+         748 => x"370500f0",
+         749 => x"23220500",
+         750 => x"03258102",
+         751 => x"e7000500",
+         752 => x"6f00801c",
+         753 => x"13056104",
+         754 => x"93050000",
+         755 => x"97100000",
+         756 => x"e78000bc",
+         757 => x"13090500",
+         758 => x"13753500",
+         759 => x"6310051a",
+         760 => x"93058000",
+         761 => x"13050900",
+         762 => x"97100000",
+         763 => x"e78000c0",
+         764 => x"13850c00",
+         765 => x"97000000",
+         766 => x"e780005f",
+         767 => x"03250900",
+         768 => x"93058000",
+         769 => x"97100000",
+         770 => x"e78040be",
+         771 => x"6f00c017",
+         772 => x"9305c103",
+         773 => x"13056104",
+         774 => x"97100000",
+         775 => x"e78040b7",
+         776 => x"13090500",
+         777 => x"13753500",
+         778 => x"631a0514",
+         779 => x"0325c103",
+         780 => x"93050000",
+         781 => x"97100000",
+         782 => x"e78080b5",
+         783 => x"2320a900",
+         784 => x"6f008014",
+         785 => x"13053104",
+         786 => x"13063000",
+         787 => x"8325c101",
+         788 => x"97100000",
+         789 => x"e78000dd",
+         790 => x"630c0504",
+         791 => x"13053104",
+         792 => x"13063000",
+         793 => x"83258101",
+         794 => x"97100000",
+         795 => x"e78080db",
+         796 => x"6300050c",
+         797 => x"13053104",
+         798 => x"13063000",
+         799 => x"83254101",
+         800 => x"97100000",
+         801 => x"e78000da",
+         802 => x"63080510",
+         803 => x"13053104",
+         804 => x"13064000",
+         805 => x"83250101",
+         806 => x"97100000",
+         807 => x"e78080d8",
+         808 => x"63080516",
+         809 => x"6382090e",
+         810 => x"03258100",
+         811 => x"6f00400d",
+         812 => x"9305c103",
+         813 => x"13056104",
+         814 => x"97100000",
+         815 => x"e78040ad",
+         816 => x"0326c103",
+         817 => x"13090500",
+         818 => x"9305c103",
+         819 => x"13050600",
+         820 => x"97100000",
+         821 => x"e780c0ab",
+         822 => x"8325c103",
+         823 => x"93090500",
+         824 => x"13850500",
+         825 => x"93050000",
+         826 => x"97100000",
+         827 => x"e78040aa",
+         828 => x"93753900",
+         829 => x"63940508",
+         830 => x"93853900",
+         831 => x"13060900",
+         832 => x"93064000",
+         833 => x"63e0d502",
+         834 => x"93d52500",
+         835 => x"93060900",
+         836 => x"13864600",
+         837 => x"9385f5ff",
+         838 => x"23a0a600",
+         839 => x"93060600",
+         840 => x"e39805fe",
+         841 => x"93058000",
+         842 => x"13050600",
+         843 => x"6ff09fed",
+         844 => x"9305c103",
+         845 => x"13056104",
+         846 => x"97100000",
+         847 => x"e78040a5",
+         848 => x"0326c103",
+         849 => x"13090500",
+         850 => x"9305c103",
+         851 => x"13050600",
+         852 => x"97100000",
+         853 => x"e780c0a3",
+         854 => x"8325c103",
+         855 => x"93090500",
+         856 => x"13850500",
+         857 => x"93050000",
+         858 => x"97100000",
+         859 => x"e78040a2",
+         860 => x"b3e52901",
+         861 => x"93f53500",
+         862 => x"638c050c",
+         863 => x"03254102",
+         864 => x"97000000",
+         865 => x"e7804046",
+         866 => x"13850400",
+         867 => x"97000000",
+         868 => x"e7808045",
+         869 => x"6ff09fca",
+         870 => x"9305c103",
+         871 => x"13056104",
+         872 => x"97100000",
+         873 => x"e780c09e",
+         874 => x"0326c103",
+         875 => x"130d0500",
+         876 => x"9305c103",
+         877 => x"13050600",
+         878 => x"97100000",
+         879 => x"e780409d",
+         880 => x"8325c103",
+         881 => x"93090500",
+         882 => x"13850500",
+         883 => x"93050000",
+         884 => x"97100000",
+         885 => x"e780c09b",
+         886 => x"63080502",
+         887 => x"93850900",
+         888 => x"13060d00",
+         889 => x"83460600",
+         890 => x"03c70500",
+         891 => x"6394e60a",
+         892 => x"13061600",
+         893 => x"93851500",
+         894 => x"1305f5ff",
+         895 => x"93891900",
+         896 => x"130d1d00",
+         897 => x"e31005fe",
+         898 => x"0325c100",
+         899 => x"6ff05ff7",
+         900 => x"9305c103",
+         901 => x"13057104",
+         902 => x"97100000",
+         903 => x"e7804097",
+         904 => x"8325c103",
+         905 => x"13090500",
+         906 => x"13850500",
+         907 => x"93050000",
+         908 => x"97100000",
+         909 => x"e780c095",
+         910 => x"13060500",
+         911 => x"13050000",
+         912 => x"93050900",
+         913 => x"97000000",
+         914 => x"e780400d",
+         915 => x"6ff05fdb",
+         916 => x"13063500",
+         917 => x"93552600",
+         918 => x"13952500",
+         919 => x"93064000",
+         920 => x"63f42907",
+         921 => x"6368d608",
+         922 => x"3386a900",
+         923 => x"1306c6ff",
+         924 => x"b306a900",
+         925 => x"9386c6ff",
+         926 => x"03270600",
+         927 => x"9385f5ff",
+         928 => x"23a0e600",
+         929 => x"1306c6ff",
+         930 => x"9386c6ff",
+         931 => x"e39605fe",
+         932 => x"6f004006",
+         933 => x"03254100",
+         934 => x"97000000",
+         935 => x"e780c034",
+         936 => x"93058000",
+         937 => x"13050d00",
+         938 => x"97100000",
+         939 => x"e7800094",
+         940 => x"03250100",
+         941 => x"97000000",
+         942 => x"e7800033",
+         943 => x"93058000",
+         944 => x"13850900",
+         945 => x"6ff01fd4",
+         946 => x"6366d602",
+         947 => x"13061000",
+         948 => x"6364b600",
+         949 => x"93051000",
+         950 => x"13060900",
+         951 => x"83a60900",
+         952 => x"2320d600",
+         953 => x"9385f5ff",
+         954 => x"13064600",
+         955 => x"93894900",
+         956 => x"e39605fe",
+         957 => x"3305a900",
+         958 => x"6ff09fd0",
+         959 => x"370500f0",
+         960 => x"23220500",
+         961 => x"97000000",
+         962 => x"e780c029",
+         963 => x"37850020",
+         964 => x"130505c0",
+         965 => x"23200500",
+         966 => x"1345f5ff",
+         967 => x"63000604",
+         968 => x"b786b8ed",
+         969 => x"93860632",
+         970 => x"03c70500",
+         971 => x"1306f6ff",
+         972 => x"3345e500",
+         973 => x"13078000",
+         974 => x"93571500",
+         975 => x"13751500",
+         976 => x"3305a040",
+         977 => x"3375d500",
+         978 => x"1307f7ff",
+         979 => x"3345f500",
+         980 => x"e31407fe",
+         981 => x"93851500",
+         982 => x"e31806fc",
+         983 => x"1345f5ff",
+         984 => x"67800000",
+         985 => x"130101ff",
+         986 => x"23261100",
+         987 => x"23248100",
+         988 => x"23229100",
+         989 => x"23202101",
+         990 => x"b70400f0",
+         991 => x"93051000",
+         992 => x"23a0b40a",
+         993 => x"83a5440a",
+         994 => x"93f50501",
+         995 => x"13040500",
+         996 => x"639e0500",
+         997 => x"23a0040a",
+         998 => x"37250010",
+         999 => x"1305e5a8",
+        1000 => x"97000000",
+        1001 => x"e7804024",
+        1002 => x"6f00800e",
+        1003 => x"37250010",
+        1004 => x"130595b1",
+        1005 => x"97000000",
+        1006 => x"e7800023",
+        1007 => x"03a5840a",
+        1008 => x"83a5040f",
+        1009 => x"03a6440a",
+        1010 => x"13761600",
+        1011 => x"631e0602",
+        1012 => x"370600f0",
+        1013 => x"b7861e00",
+        1014 => x"93860648",
+        1015 => x"0327860a",
+        1016 => x"631aa700",
+        1017 => x"0327060f",
+        1018 => x"3307b740",
+        1019 => x"63f8e600",
+        1020 => x"6f008001",
+        1021 => x"0325860a",
+        1022 => x"8325060f",
+        1023 => x"0327460a",
+        1024 => x"13771700",
+        1025 => x"e30c07fc",
+        1026 => x"370500f0",
+        1027 => x"1305050a",
+        1028 => x"23200500",
+        1029 => x"37850100",
+        1030 => x"9304056a",
+        1031 => x"1309f0ff",
+        1032 => x"13850400",
+        1033 => x"97000000",
+        1034 => x"e7808023",
+        1035 => x"b325a900",
+        1036 => x"130565ff",
+        1037 => x"3335a000",
+        1038 => x"33f5a500",
+        1039 => x"e31205fe",
+        1040 => x"1305c004",
+        1041 => x"97000000",
+        1042 => x"e7800018",
+        1043 => x"b70400f0",
+        1044 => x"03a5440a",
+        1045 => x"93052000",
+        1046 => x"97000000",
+        1047 => x"e7800079",
+        1048 => x"03a5840a",
+        1049 => x"93058000",
+        1050 => x"97000000",
+        1051 => x"e7800078",
+        1052 => x"37250010",
+        1053 => x"1305d5af",
+        1054 => x"97000000",
+        1055 => x"e780c016",
+        1056 => x"03a5440a",
+        1057 => x"13751500",
+        1058 => x"63040500",
+        1059 => x"03a4c40a",
+        1060 => x"13050400",
+        1061 => x"8320c100",
+        1062 => x"03248100",
+        1063 => x"83244100",
+        1064 => x"03290100",
+        1065 => x"13010101",
+        1066 => x"67800000",
+        1067 => x"130101fe",
+        1068 => x"232ea100",
+        1069 => x"232cb100",
+        1070 => x"232ac100",
+        1071 => x"2328d100",
+        1072 => x"2326e100",
+        1073 => x"73252034",
+        1074 => x"b7050080",
+        1075 => x"93852501",
+        1076 => x"631eb502",
+        1077 => x"370500f0",
+        1078 => x"03250502",
+        1079 => x"b7050020",
+        1080 => x"03a60500",
+        1081 => x"b7060020",
+        1082 => x"83a64600",
+        1083 => x"13061600",
+        1084 => x"1376f67f",
+        1085 => x"631ed600",
+        1086 => x"37050020",
+        1087 => x"83258500",
+        1088 => x"93851500",
+        1089 => x"2324b500",
+        1090 => x"6f004002",
+        1091 => x"6f000000",
+        1092 => x"83a60500",
+        1093 => x"93850500",
+        1094 => x"37070020",
+        1095 => x"13070712",
+        1096 => x"b386e600",
+        1097 => x"2380a600",
+        1098 => x"23a0c500",
+        1099 => x"0325c101",
+        1100 => x"83258101",
+        1101 => x"03264101",
+        1102 => x"83260101",
+        1103 => x"0327c100",
+        1104 => x"13010102",
+        1105 => x"73002030",
+        1106 => x"37150000",
+        1107 => x"13057545",
+        1108 => x"b70500f0",
+        1109 => x"23a2a502",
+        1110 => x"37050020",
+        1111 => x"23240500",
+        1112 => x"37050020",
+        1113 => x"23220500",
+        1114 => x"37050020",
+        1115 => x"23200500",
+        1116 => x"37150010",
+        1117 => x"1305c50a",
+        1118 => x"73105530",
+        1119 => x"13050004",
+        1120 => x"23a4a502",
+        1121 => x"73600430",
+        1122 => x"67800000",
+        1123 => x"37150000",
+        1124 => x"13057545",
+        1125 => x"b70500f0",
+        1126 => x"23a2a502",
+        1127 => x"67800000",
+        1128 => x"73700430",
+        1129 => x"370500f0",
+        1130 => x"23240502",
+        1131 => x"23220502",
+        1132 => x"67800000",
+        1133 => x"b7050020",
+        1134 => x"03a58500",
+        1135 => x"23a40500",
+        1136 => x"67800000",
+        1137 => x"9375f50f",
+        1138 => x"370500f0",
+        1139 => x"13060502",
+        1140 => x"2320b600",
+        1141 => x"8325c502",
+        1142 => x"93f50501",
+        1143 => x"e38c05fe",
+        1144 => x"67800000",
+        1145 => x"630a0502",
+        1146 => x"83460500",
+        1147 => x"63860602",
+        1148 => x"b70500f0",
+        1149 => x"13860502",
+        1150 => x"93f6f60f",
+        1151 => x"2320d600",
+        1152 => x"83a6c502",
+        1153 => x"93f60601",
+        1154 => x"e38c06fe",
+        1155 => x"83461500",
+        1156 => x"13051500",
+        1157 => x"e39206fe",
+        1158 => x"67800000",
+        1159 => x"37050020",
+        1160 => x"b7050020",
+        1161 => x"03260500",
+        1162 => x"83a64500",
+        1163 => x"e30cd6fe",
+        1164 => x"b7050020",
+        1165 => x"03a54500",
+        1166 => x"37060020",
+        1167 => x"13060612",
+        1168 => x"3305c500",
+        1169 => x"03450500",
+        1170 => x"03a64500",
+        1171 => x"13061600",
+        1172 => x"1376f67f",
+        1173 => x"23a2c500",
+        1174 => x"67800000",
+        1175 => x"b70500f0",
+        1176 => x"03a6050f",
+        1177 => x"b7060020",
+        1178 => x"37070020",
+        1179 => x"83a70600",
+        1180 => x"03284700",
+        1181 => x"639c0701",
+        1182 => x"83a7050f",
+        1183 => x"b387c740",
+        1184 => x"e376f5fe",
+        1185 => x"1305f0ff",
+        1186 => x"67800000",
+        1187 => x"b7050020",
+        1188 => x"03a54500",
+        1189 => x"37060020",
+        1190 => x"13060612",
+        1191 => x"3305c500",
+        1192 => x"03450500",
+        1193 => x"03a64500",
+        1194 => x"13061600",
+        1195 => x"1376f67f",
+        1196 => x"23a2c500",
+        1197 => x"67800000",
+        1198 => x"130101ff",
+        1199 => x"23261100",
+        1200 => x"13058000",
+        1201 => x"97000000",
+        1202 => x"e780405b",
+        1203 => x"b7050020",
+        1204 => x"37060020",
+        1205 => x"b7060020",
+        1206 => x"93860612",
+        1207 => x"1307a000",
+        1208 => x"83a70500",
+        1209 => x"03284600",
+        1210 => x"e38c07ff",
+        1211 => x"83274600",
+        1212 => x"b387d700",
+        1213 => x"83c70700",
+        1214 => x"03284600",
+        1215 => x"13081800",
+        1216 => x"1378f87f",
+        1217 => x"23220601",
+        1218 => x"e39ce7fc",
+        1219 => x"630a0504",
+        1220 => x"b7f5fa02",
+        1221 => x"13860508",
+        1222 => x"93551500",
+        1223 => x"b385c500",
+        1224 => x"b3d5a502",
+        1225 => x"b706ffff",
+        1226 => x"1387f6ff",
+        1227 => x"3387e500",
+        1228 => x"9386f600",
+        1229 => x"6366d702",
+        1230 => x"3385a502",
+        1231 => x"6366a600",
+        1232 => x"3305a640",
+        1233 => x"6f000001",
+        1234 => x"371605fd",
+        1235 => x"130606f8",
+        1236 => x"3305c500",
+        1237 => x"37460f00",
+        1238 => x"13060624",
+        1239 => x"6376a604",
+        1240 => x"37250010",
+        1241 => x"1305e5a8",
+        1242 => x"1307f003",
+        1243 => x"b70500f0",
+        1244 => x"13860502",
+        1245 => x"93062500",
+        1246 => x"1377f70f",
+        1247 => x"2320e600",
+        1248 => x"03a7c502",
+        1249 => x"13770701",
+        1250 => x"e30c07fe",
+        1251 => x"03471500",
+        1252 => x"93071500",
+        1253 => x"13850700",
+        1254 => x"e390d7fe",
+        1255 => x"8320c100",
+        1256 => x"13010101",
+        1257 => x"67800000",
+        1258 => x"37250010",
+        1259 => x"1305f5b1",
+        1260 => x"93072005",
+        1261 => x"370600f0",
+        1262 => x"93060602",
+        1263 => x"13072500",
+        1264 => x"93f7f70f",
+        1265 => x"23a0f600",
+        1266 => x"8327c602",
+        1267 => x"93f70701",
+        1268 => x"e38c07fe",
+        1269 => x"83471500",
+        1270 => x"13081500",
+        1271 => x"13050800",
+        1272 => x"e310e8fe",
+        1273 => x"13060000",
+        1274 => x"b70600f0",
+        1275 => x"03a54602",
+        1276 => x"9385f5ff",
+        1277 => x"23a2b602",
+        1278 => x"b7050020",
+        1279 => x"37070020",
+        1280 => x"b7170300",
+        1281 => x"938707d4",
+        1282 => x"37080020",
+        1283 => x"13080812",
+        1284 => x"b7280010",
+        1285 => x"9388d8cc",
+        1286 => x"93028000",
+        1287 => x"03a3060f",
+        1288 => x"83a30500",
+        1289 => x"032e4700",
+        1290 => x"639ac301",
+        1291 => x"83a3060f",
+        1292 => x"b3836340",
+        1293 => x"e3f677fe",
+        1294 => x"6f008003",
+        1295 => x"03234700",
+        1296 => x"33030301",
+        1297 => x"03430300",
+        1298 => x"83234700",
+        1299 => x"330e1601",
+        1300 => x"034e0e00",
+        1301 => x"93831300",
+        1302 => x"93f3f37f",
+        1303 => x"23227700",
+        1304 => x"6318c301",
+        1305 => x"13061600",
+        1306 => x"e31a56fa",
+        1307 => x"6f00c000",
+        1308 => x"93058000",
+        1309 => x"6310b60a",
+        1310 => x"93050000",
+        1311 => x"37260010",
+        1312 => x"1306d6cc",
+        1313 => x"b70600f0",
+        1314 => x"13870602",
+        1315 => x"93078000",
+        1316 => x"3388c500",
+        1317 => x"03480800",
+        1318 => x"23200701",
+        1319 => x"03a8c602",
+        1320 => x"13780801",
+        1321 => x"e30c08fe",
+        1322 => x"93851500",
+        1323 => x"e392f5fe",
+        1324 => x"b70500f0",
+        1325 => x"03a6050f",
+        1326 => x"b7060020",
+        1327 => x"37070020",
+        1328 => x"b7170300",
+        1329 => x"938707d4",
+        1330 => x"03a80600",
+        1331 => x"83284700",
+        1332 => x"631a1801",
+        1333 => x"03a8050f",
+        1334 => x"3308c840",
+        1335 => x"e3f607ff",
+        1336 => x"6f004003",
+        1337 => x"b7050020",
+        1338 => x"03a64500",
+        1339 => x"b7060020",
+        1340 => x"93860612",
+        1341 => x"3306d600",
+        1342 => x"03460600",
+        1343 => x"83a64500",
+        1344 => x"93861600",
+        1345 => x"93f6f67f",
+        1346 => x"1307500a",
+        1347 => x"23a2d500",
+        1348 => x"e306e6e8",
+        1349 => x"b70500f0",
+        1350 => x"37060020",
+        1351 => x"b7060020",
+        1352 => x"37170300",
+        1353 => x"130707d4",
+        1354 => x"b7070020",
+        1355 => x"93870712",
+        1356 => x"03a8050f",
+        1357 => x"83280600",
+        1358 => x"83a24600",
+        1359 => x"639a5800",
+        1360 => x"83a8050f",
+        1361 => x"b3880841",
+        1362 => x"e37617ff",
+        1363 => x"6f004002",
+        1364 => x"03a84600",
+        1365 => x"3308f800",
+        1366 => x"03080800",
+        1367 => x"03a84600",
+        1368 => x"13081800",
+        1369 => x"1378f87f",
+        1370 => x"23a20601",
+        1371 => x"6ff05ffc",
+        1372 => x"b70500f0",
+        1373 => x"93854502",
+        1374 => x"23a0a500",
+        1375 => x"6ff01fe2",
+        1376 => x"37050020",
+        1377 => x"03250500",
+        1378 => x"b7050020",
+        1379 => x"83a54500",
+        1380 => x"3345b500",
+        1381 => x"3335a000",
+        1382 => x"67800000",
+        1383 => x"130101fe",
+        1384 => x"232e8100",
+        1385 => x"232c9100",
+        1386 => x"232a2101",
+        1387 => x"23283101",
+        1388 => x"23264101",
+        1389 => x"23245101",
+        1390 => x"23226101",
+        1391 => x"13060000",
+        1392 => x"9385f5ff",
+        1393 => x"b7060020",
+        1394 => x"37070020",
+        1395 => x"b7070020",
+        1396 => x"93870712",
+        1397 => x"1308c000",
+        1398 => x"93083000",
+        1399 => x"b7220010",
+        1400 => x"9382c2a9",
+        1401 => x"370300f0",
+        1402 => x"93030302",
+        1403 => x"138e9200",
+        1404 => x"930e8000",
+        1405 => x"130fa000",
+        1406 => x"930ff007",
+        1407 => x"13047000",
+        1408 => x"9304e005",
+        1409 => x"13095001",
+        1410 => x"93091000",
+        1411 => x"130ad000",
+        1412 => x"83aa0600",
+        1413 => x"032b4700",
+        1414 => x"e38c6aff",
+        1415 => x"832a4700",
+        1416 => x"b38afa00",
+        1417 => x"83ca0a00",
+        1418 => x"032b4700",
+        1419 => x"130b1b00",
+        1420 => x"137bfb7f",
+        1421 => x"23226701",
+        1422 => x"634a5801",
+        1423 => x"638a1a03",
+        1424 => x"638ada01",
+        1425 => x"639eea09",
+        1426 => x"6f00800d",
+        1427 => x"638a2a05",
+        1428 => x"6396fa09",
+        1429 => x"635ac006",
+        1430 => x"23a0f301",
+        1431 => x"832ac302",
+        1432 => x"93fa0a01",
+        1433 => x"e38c0afe",
+        1434 => x"1306f6ff",
+        1435 => x"6ff05ffa",
+        1436 => x"930ac003",
+        1437 => x"13860200",
+        1438 => x"93fafa0f",
+        1439 => x"23a05301",
+        1440 => x"832ac302",
+        1441 => x"93fa0a01",
+        1442 => x"e38c0afe",
+        1443 => x"834a1600",
+        1444 => x"130b1600",
+        1445 => x"13060b00",
+        1446 => x"e310cbff",
+        1447 => x"6f004002",
+        1448 => x"e358c0f6",
+        1449 => x"930a0600",
+        1450 => x"23a0f301",
+        1451 => x"0326c302",
+        1452 => x"13760601",
+        1453 => x"e30c06fe",
+        1454 => x"1386faff",
+        1455 => x"e3c459ff",
+        1456 => x"13060000",
+        1457 => x"6ff0dff4",
+        1458 => x"23a08300",
+        1459 => x"832ac302",
+        1460 => x"93fa0a01",
+        1461 => x"e38c0afe",
+        1462 => x"6ff09ff3",
+        1463 => x"63824a05",
+        1464 => x"6356b602",
+        1465 => x"138b0afe",
+        1466 => x"e3e464f3",
+        1467 => x"330bc500",
+        1468 => x"23005b01",
+        1469 => x"23a05301",
+        1470 => x"832ac302",
+        1471 => x"93fa0a01",
+        1472 => x"e38c0afe",
+        1473 => x"13061600",
+        1474 => x"6ff09ff0",
+        1475 => x"23a08300",
+        1476 => x"832ac302",
+        1477 => x"93fa0a01",
+        1478 => x"e38c0afe",
+        1479 => x"6ff05fef",
+        1480 => x"3305c500",
+        1481 => x"23000500",
+        1482 => x"37250010",
+        1483 => x"130595ac",
+        1484 => x"9307d000",
+        1485 => x"b70500f0",
+        1486 => x"93860502",
+        1487 => x"13072500",
+        1488 => x"93f7f70f",
+        1489 => x"23a0f600",
+        1490 => x"83a7c502",
+        1491 => x"93f70701",
+        1492 => x"e38c07fe",
+        1493 => x"83471500",
+        1494 => x"13081500",
+        1495 => x"13050800",
+        1496 => x"e310e8fe",
+        1497 => x"13050600",
+        1498 => x"0324c101",
+        1499 => x"83248101",
+        1500 => x"03294101",
+        1501 => x"83290101",
+        1502 => x"032ac100",
+        1503 => x"832a8100",
+        1504 => x"032b4100",
+        1505 => x"13010102",
+        1506 => x"67800000",
+        1507 => x"1306f5ff",
+        1508 => x"13050002",
+        1509 => x"83471600",
+        1510 => x"13061600",
+        1511 => x"e38ca7fe",
+        1512 => x"13050000",
+        1513 => x"9306a000",
+        1514 => x"1307a0ff",
+        1515 => x"93f7f70f",
+        1516 => x"138807fd",
+        1517 => x"636ad800",
+        1518 => x"93e70702",
+        1519 => x"138897f9",
+        1520 => x"636ee800",
+        1521 => x"138897fa",
+        1522 => x"83471600",
+        1523 => x"13154500",
+        1524 => x"13061600",
+        1525 => x"3365a800",
+        1526 => x"6ff05ffd",
+        1527 => x"63840500",
+        1528 => x"23a0c500",
+        1529 => x"67800000",
+        1530 => x"130101fe",
+        1531 => x"232e1100",
+        1532 => x"232c8100",
+        1533 => x"232a9100",
+        1534 => x"23282101",
+        1535 => x"23263101",
+        1536 => x"23244101",
+        1537 => x"13040500",
+        1538 => x"138675ff",
+        1539 => x"930680ff",
+        1540 => x"13058000",
+        1541 => x"6364d600",
+        1542 => x"13850500",
+        1543 => x"93041500",
+        1544 => x"13152500",
+        1545 => x"1309c5ff",
+        1546 => x"93099003",
+        1547 => x"130a1000",
+        1548 => x"33552401",
+        1549 => x"9375f500",
+        1550 => x"13e50503",
+        1551 => x"63f4a900",
+        1552 => x"13857505",
+        1553 => x"97000000",
+        1554 => x"e7800098",
+        1555 => x"9384f4ff",
+        1556 => x"1309c9ff",
+        1557 => x"e36e9afc",
+        1558 => x"8320c101",
+        1559 => x"03248101",
+        1560 => x"83244101",
+        1561 => x"03290101",
+        1562 => x"8329c100",
+        1563 => x"032a8100",
+        1564 => x"13010102",
+        1565 => x"67800000",
+        1566 => x"130101ff",
+        1567 => x"23261100",
+        1568 => x"23248100",
+        1569 => x"23229100",
+        1570 => x"23202101",
+        1571 => x"635ea002",
+        1572 => x"13040500",
+        1573 => x"13050000",
+        1574 => x"b7250010",
+        1575 => x"938455cd",
+        1576 => x"13194500",
+        1577 => x"97000000",
+        1578 => x"e7808097",
+        1579 => x"1375f501",
+        1580 => x"33059500",
+        1581 => x"03450500",
+        1582 => x"1304f4ff",
+        1583 => x"3365a900",
+        1584 => x"e31004fe",
+        1585 => x"6f008000",
+        1586 => x"13050000",
+        1587 => x"8320c100",
+        1588 => x"03248100",
+        1589 => x"83244100",
+        1590 => x"03290100",
+        1591 => x"13010101",
+        1592 => x"67800000",
+        1593 => x"b7050020",
+        1594 => x"23a6a500",
+        1595 => x"1375c5ff",
+        1596 => x"03250500",
+        1597 => x"b7050020",
+        1598 => x"23a8a500",
+        1599 => x"67800000",
+        1600 => x"37060020",
+        1601 => x"8325c600",
+        1602 => x"93963500",
+        1603 => x"37070020",
+        1604 => x"83270701",
+        1605 => x"1308f00f",
+        1606 => x"3318d800",
+        1607 => x"1348f8ff",
+        1608 => x"b3f70701",
+        1609 => x"3315d500",
+        1610 => x"33e5a700",
+        1611 => x"2328a700",
+        1612 => x"93861500",
+        1613 => x"13f73600",
+        1614 => x"2326d600",
+        1615 => x"63040700",
+        1616 => x"67800000",
+        1617 => x"a3aea5fe",
+        1618 => x"67800000",
+        1619 => x"b7050020",
+        1620 => x"83a5c500",
+        1621 => x"3385a540",
+        1622 => x"b345b500",
+        1623 => x"13063000",
+        1624 => x"636eb600",
+        1625 => x"b7050020",
+        1626 => x"83a50501",
+        1627 => x"13153500",
+        1628 => x"33d5a500",
+        1629 => x"1375f50f",
+        1630 => x"67800000",
+        1631 => x"03450500",
+        1632 => x"67800000",
+        1633 => x"37050020",
+        1634 => x"0325c500",
+        1635 => x"93753500",
+        1636 => x"638a0502",
+        1637 => x"1375c5ff",
+        1638 => x"93953500",
+        1639 => x"1306f0ff",
+        1640 => x"83260500",
+        1641 => x"37070020",
+        1642 => x"03270701",
+        1643 => x"b315b600",
+        1644 => x"13c6f5ff",
+        1645 => x"b3f5b600",
+        1646 => x"3376c700",
+        1647 => x"b365b600",
+        1648 => x"2320b500",
+        1649 => x"67800000",
+        1650 => x"93050000",
+        1651 => x"3306b500",
+        1652 => x"03460600",
+        1653 => x"93851500",
+        1654 => x"e31a06fe",
+        1655 => x"1385f5ff",
+        1656 => x"67800000",
+        1657 => x"03460500",
+        1658 => x"63020602",
+        1659 => x"13051500",
+        1660 => x"83c60500",
+        1661 => x"1377f60f",
+        1662 => x"631cd700",
+        1663 => x"03460500",
+        1664 => x"93851500",
+        1665 => x"13051500",
+        1666 => x"e31406fe",
+        1667 => x"13060000",
+        1668 => x"03c50500",
+        1669 => x"9375f60f",
+        1670 => x"3385a540",
+        1671 => x"67800000",
+        1672 => x"63020602",
+        1673 => x"03470500",
+        1674 => x"83c60500",
+        1675 => x"63000702",
+        1676 => x"6310d702",
+        1677 => x"13051500",
+        1678 => x"1306f6ff",
+        1679 => x"93851500",
+        1680 => x"e31206fe",
+        1681 => x"13050000",
+        1682 => x"67800000",
+        1683 => x"13070000",
+        1684 => x"3305d740",
+        1685 => x"67800000",
+        1686 => x"e0060010",
+        1687 => x"34070010",
+        1688 => x"d4080010",
+        1689 => x"e4080010",
+        1690 => x"d4080010",
+        1691 => x"14080010",
+        1692 => x"d4080010",
+        1693 => x"d4080010",
+        1694 => x"d4080010",
+        1695 => x"d4080010",
+        1696 => x"d4080010",
+        1697 => x"1c070010",
+        1698 => x"28080010",
+        1699 => x"20003f0a",
+        1700 => x"00470a00",
+        1701 => x"77772000",
+        1702 => x"64772000",
+        1703 => x"3c627265",
+        1704 => x"616b3e0d",
+        1705 => x"0a007277",
+        1706 => x"20004e6f",
+        1707 => x"74206f6e",
+        1708 => x"20342d62",
+        1709 => x"79746520",
+        1710 => x"626f756e",
+        1711 => x"64617279",
+        1712 => x"21003e20",
+        1713 => x"00637720",
+        1714 => x"000d0a00",
+        1715 => x"0d0a4f76",
+        1716 => x"65727275",
+        1717 => x"6e733a20",
+        1718 => x"000d0a54",
+        1719 => x"48554153",
+        1720 => x"20524953",
+        1721 => x"432d5620",
+        1722 => x"426f6f74",
+        1723 => x"6c6f6164",
+        1724 => x"65722076",
+        1725 => x"302e320d",
+        1726 => x"0a00480a",
+        1727 => x"000a0072",
+        1728 => x"00202000",
+        1729 => x"636d2000",
+        1730 => x"45717561",
+        1731 => x"6c004469",
+        1732 => x"66666572",
+        1733 => x"20617420",
+        1734 => x"004c0a00",
+        1735 => x"3a200052",
+        1736 => x"0a006372",
+        1737 => x"6320003f",
+        1738 => x"3f006800",
+        1739 => x"48656c70",
+        1740 => x"3a0d0a20",
+        1741 => x"68202020",
+        1742 => x"20202020",
+        1743 => x"20202020",
+        1744 => x"20202020",
+        1745 => x"202d2074",
+        1746 => x"68697320",
+        1747 => x"68656c70",
+        1748 => x"0d0a2072",
+        1749 => x"20202020",
+        1750 => x"20202020",
+        1751 => x"20202020",
+        1752 => x"20202020",
+        1753 => x"2d207275",
+        1754 => x"6e206170",
+        1755 => x"706c6963",
+        1756 => x"6174696f",
+        1757 => x"6e0d0a20",
+        1758 => x"7277203c",
+        1759 => x"61646472",
+        1760 => x"3e202020",
+        1761 => x"20202020",
+        1762 => x"202d2072",
+        1763 => x"65616420",
+        1764 => x"776f7264",
+        1765 => x"2066726f",
+        1766 => x"6d206164",
+        1767 => x"64720d0a",
+        1768 => x"20777720",
+        1769 => x"3c616464",
+        1770 => x"723e203c",
+        1771 => x"64617461",
+        1772 => x"3e202d20",
+        1773 => x"77726974",
+        1774 => x"65206461",
+        1775 => x"74612061",
+        1776 => x"74206164",
+        1777 => x"64720d0a",
+        1778 => x"20647720",
+        1779 => x"3c616464",
+        1780 => x"723e2020",
+        1781 => x"20202020",
+        1782 => x"20202d20",
+        1783 => x"64756d70",
+        1784 => x"20313620",
+        1785 => x"776f7264",
+        1786 => x"730d0a20",
+        1787 => x"6e202020",
+        1788 => x"20202020",
+        1789 => x"20202020",
+        1790 => x"20202020",
+        1791 => x"202d2064",
+        1792 => x"756d7020",
+        1793 => x"6e657874",
+        1794 => x"20313620",
+        1795 => x"776f7264",
+        1796 => x"730d0a20",
+        1797 => x"6677203c",
+        1798 => x"613e203c",
+        1799 => x"6e3e203c",
+        1800 => x"643e2020",
+        1801 => x"202d2066",
+        1802 => x"696c6c20",
+        1803 => x"6e206279",
+        1804 => x"74657320",
+        1805 => x"61742061",
+        1806 => x"20776974",
+        1807 => x"6820640d",
+        1808 => x"0a206377",
+        1809 => x"203c643e",
+        1810 => x"203c733e",
+        1811 => x"203c6e3e",
+        1812 => x"2020202d",
+        1813 => x"20636f70",
+        1814 => x"79206e20",
+        1815 => x"62797465",
+        1816 => x"73206672",
+        1817 => x"6f6d2073",
+        1818 => x"20746f20",
+        1819 => x"640d0a20",
+        1820 => x"636d203c",
+        1821 => x"613e203c",
+        1822 => x"623e203c",
+        1823 => x"6e3e2020",
+        1824 => x"202d2063",
+        1825 => x"6f6d7061",
+        1826 => x"7265206e",
+        1827 => x"20627974",
+        1828 => x"65732061",
+        1829 => x"74206120",
+        1830 => x"616e6420",
+        1831 => x"620d0a20",
+        1832 => x"63726320",
+        1833 => x"3c613e20",
+        1834 => x"3c6e3e20",
+        1835 => x"20202020",
+        1836 => x"202d2043",
+        1837 => x"52433332",
+        1838 => x"206f6620",
+        1839 => x"6e206279",
+        1840 => x"74657320",
+        1841 => x"61742061",
+        1842 => x"00667720",
+        1843 => x"0055aa00",
+        1844 => x"ff0ff033",
+        1845 => x"cc000a0b",
+        1846 => x"0c0d0e0f",
+        1847 => x"00000000",
+        1848 => x"00000000",
+        1849 => x"00000102",
+        1850 => x"03040506",
+        1851 => x"07080900",
+        1852 => x"00000000",
+        1853 => x"00000000",
          others => (others => '0')
         );
 
+-- Quartus initializes the bootloader ROM from a MIF file, if set
+attribute ram_init_file : string;
+attribute ram_init_file of bootrom : signal is bootloader_mif_file;
+
 begin
 
     gen_bootrom: if HAVE_BOOT_ROM generate
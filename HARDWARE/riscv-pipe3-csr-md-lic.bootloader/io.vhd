@@ -18,7 +18,37 @@
 -- are available. A simple timer TIMER1 is provided, has no
 -- prescaler and generates an interrupt when the CMPT register
 -- is equal to or greater than the TCNT register. The TIME and
--- TIMECMP registers are provided. 
+-- TIMECMP registers are provided. The registers of the hardware
+-- loader are provided, while the loader is enabled the received
+-- bytes are handed to the loader.
+--
+-- The UART has a transmit and a receive FIFO of usart_fifo_size
+-- entries, enabled with FEN in the control register. With the
+-- FIFOs disabled, the UART works as before. With the FIFOs
+-- enabled, a write to the data register puts the data in the
+-- transmit FIFO (dropped if TF is set) and a read returns the
+-- oldest byte of the receive FIFO. A byte received while the
+-- receive FIFO is full is lost and sets OR. The receive
+-- threshold flag RXT is set if the receive FIFO holds at least
+-- the RX threshold number of bytes (at least 1), the transmit
+-- threshold flag TXT if the transmit FIFO holds at most the TX
+-- threshold number of bytes. RXT and TXT are levels, not events:
+-- with RXTIE or TXTIE set, the interrupt is asserted for as long
+-- as the flag is set, so a handler with nothing more to send
+-- clears TXTIE. RT is set if bytes are waiting in the receive
+-- FIFO and nothing is received for 40 bit times (4 characters),
+-- it is cleared by reading the data register.
+-- FIFO reads and writes only count if the instruction
+-- retires, so an interrupted load or store does not lose or
+-- duplicate data. Clearing FEN empties both FIFOs.
+--
+-- USARTCTRL bits:
+--   0: two stop bits, 3..2: data bits, 5..4: parity,
+--   6: RCIE, 7: TCIE, 8: FEN, 9: RXTIE, 10: TXTIE, 11: RTIE,
+--   23..16: RX threshold, 31..24: TX threshold
+-- USARTSTAT bits:
+--   0: FE, 1: RF, 2: RC, 3: PE, 4: TC, 5: RT, 6: OR, 7: TF,
+--   8: RXT, 9: TXT, 23..16: RX FIFO level, 31..24: TX FIFO level
 
 library ieee;
 use ieee.std_logic_1164.all;
@@ -50,7 +80,16 @@ entity io is
           O_intrio : out data_type;
           -- TIME and TIMEH
           O_time : out data_type;
-          O_timeh : out data_type
+          O_timeh : out data_type;
+          -- Hardware loader
+          O_loadenable : out std_logic;
+          O_rxdata : out std_logic_vector(7 downto 0);
+          O_rxvalid : out std_logic;
+          I_loadstat : in data_type;
+          I_loadcount : in data_type;
+          I_loadstart : in data_type;
+          -- Instruction retired, for the USART FIFOs
+          I_instret : in std_logic
          );
 end entity io;
     
@@ -80,7 +119,7 @@ alias usartstat_int : data_type is io(usartstat_addr);
 -- Transmit signals
 signal txbuffer : data_type;
 signal txstart : std_logic;
-type txstate_type is (tx_idle, tx_iter, tx_ready);
+type txstate_type is (tx_idle, tx_load, tx_iter, tx_ready);
 signal txstate : txstate_type;
 signal txbittimer : integer range 0 to 65535;
 signal txshiftcounter : integer range 0 to 15;
@@ -91,6 +130,68 @@ signal rxstate : rxstate_type;
 signal rxbittimer : integer range 0 to 65535;
 signal rxshiftcounter : integer range 0 to 15;
 signal RxD_sync : std_logic;
+-- FIFOs, the pointers have an extra bit to tell full from empty
+signal fifoenable : std_logic;
+signal txfifo : usart_fifo_type;
+signal txhead, txtail : unsigned(usart_fifo_size_bits downto 0);
+signal txlevel : unsigned(usart_fifo_size_bits downto 0);
+signal txfifo_q : std_logic_vector(8 downto 0);
+signal rxfifo : usart_fifo_type;
+signal rxhead, rxtail : unsigned(usart_fifo_size_bits downto 0);
+signal rxlevel : unsigned(usart_fifo_size_bits downto 0);
+signal rxfifo_q : std_logic_vector(8 downto 0);
+signal rxfifo_valid : std_logic;
+signal rxthreshold : std_logic;
+signal txthreshold : std_logic;
+-- Receive timeout, counts bit times
+signal rxtobittimer : integer range 0 to 65535;
+signal rxtocount : integer range 0 to 40;
+-- The data and status register as read by the processor
+signal usartdata_read : data_type;
+signal usartstat_read : data_type;
+
+-- Transmit frame with 7/8/9 data bits, parity bit and a start
+-- bit. Stop bits will be automatically added since the
+-- remaining bits are set to 1. Most right bit is start bit.
+function txframe(data : std_logic_vector(8 downto 0); ctrl : data_type) return data_type is
+variable frame : data_type;
+begin
+    frame := (others => '1');
+    if ctrl(3 downto 2) = "10" then
+        -- 9 bits data
+        frame(9 downto 0) := data(8 downto 0) & '0';
+        -- Have parity
+        if ctrl(5) = '1' then
+            frame(10) := data(8) xor data(7) xor data(6) xor data(5) xor data(4)
+                         xor data(3) xor data(2) xor data(1) xor data(0) xor ctrl(4);
+        end if;
+    elsif ctrl(3 downto 2) = "11" then
+        -- 7 bits data
+        frame(7 downto 0) := data(6 downto 0) & '0';
+        -- Have parity
+        if ctrl(5) = '1' then
+            frame(8) := data(6) xor data(5) xor data(4) xor data(3)
+                        xor data(2) xor data(1) xor data(0) xor ctrl(4);
+        end if;
+    else
+        -- 8 bits data
+        frame(8 downto 0) := data(7 downto 0) & '0';
+        -- Have parity
+        if ctrl(5) = '1' then
+            frame(9) := data(7) xor data(6) xor data(5) xor data(4) xor data(3)
+                        xor data(2) xor data(1) xor data(0) xor ctrl(4);
+        end if;
+    end if;
+    return frame;
+end function txframe;
+
+-- Hardware loader
+constant loadctrl_addr : integer := 40;
+constant loadstat_addr : integer := 41;
+constant loadcnt_addr : integer := 42;
+constant loadstart_addr : integer := 43;
+alias loadctrl_int : data_type is io(loadctrl_addr);
+signal loadenable_int : std_logic;
 
 -- Timer/Counters
 constant timer1ctrl_addr : integer := 32;
@@ -135,10 +236,10 @@ begin
                 case reg_int is
                     when pina_addr => O_dataout <= pina_int;
                     when pouta_addr => O_dataout <= pouta_int;
-                    when usartdata_addr => O_dataout <= usartdata_int;
+                    when usartdata_addr => O_dataout <= usartdata_read;
                     when usartbaud_addr => O_dataout <= usartbaud_int;
                     when usartctrl_addr => O_dataout <= usartctrl_int;
-                    when usartstat_addr => O_dataout <= usartstat_int;
+                    when usartstat_addr => O_dataout <= usartstat_read;
                     when timer1cntr_addr => O_dataout <= timer1cntr_int;
                     when timer1ctrl_addr => O_dataout <= timer1ctrl_int;
                     when timer1stat_addr => O_dataout <= timer1stat_int;
@@ -147,6 +248,10 @@ begin
                     when timeh_addr => O_dataout <= timeh_int;
                     when timecmp_addr => O_dataout <= timecmp_int;
                     when timecmph_addr => O_dataout <= timecmph_int;
+                    when loadctrl_addr => O_dataout <= loadctrl_int;
+                    when loadstat_addr => O_dataout <= I_loadstat;
+                    when loadcnt_addr => O_dataout <= I_loadcount;
+                    when loadstart_addr => O_dataout <= I_loadstart;
                     when others => O_dataout <= (others => '-');
                 end case;
             end if;
@@ -175,10 +280,30 @@ begin
     end process;
      -- Data to outside world
     O_pouta <= pouta_int;
+
+    -- Hardware loader control, bit 0 enables the loader
+    process (I_clk, I_areset) is
+    begin
+        if I_areset = '1' then
+            loadctrl_int <= (others => '0');
+        elsif rising_edge(I_clk) then
+            if isword and I_csio = '1' and I_wren = '1' then
+                if reg_int = loadctrl_addr then
+                    loadctrl_int <= I_datain;
+                end if;
+            end if;
+        end if;
+    end process;
+    loadenable_int <= loadctrl_int(0) when HAVE_LOADER else '0';
+    O_loadenable <= loadenable_int;
     
     -- USART (well, really an UART)
     process (I_clk, I_areset) is
     variable txshiftcounter_var : integer range 0 to 15;
+    variable txpush : boolean;
+    variable rxpop : boolean;
+    variable rxnext : unsigned(usart_fifo_size_bits downto 0);
+    variable rxdata : std_logic_vector(8 downto 0);
     begin
         -- Common resets et al.
         if I_areset = '1' then
@@ -197,9 +322,26 @@ begin
             rxbittimer <= 0;
             rxshiftcounter <= 0;
             RxD_sync <= '1';
+            O_rxdata <= (others => '0');
+            O_rxvalid <= '0';
+            txhead <= (others => '0');
+            txtail <= (others => '0');
+            txfifo_q <= (others => '0');
+            rxhead <= (others => '0');
+            rxtail <= (others => '0');
+            rxfifo_q <= (others => '0');
+            rxfifo_valid <= '0';
+            rxtobittimer <= 0;
+            rxtocount <= 0;
         elsif rising_edge(I_clk) then
             -- Default for start transmission
             txstart <= '0';
+            -- Default no byte for the loader
+            O_rxvalid <= '0';
+            txpush := false;
+            rxpop := false;
+            -- Read the oldest entry of the transmit FIFO
+            txfifo_q <= txfifo(to_integer(txtail(usart_fifo_size_bits-1 downto 0)));
             -- Common register writes
             if isword and I_csio = '1' and I_wren = '1' then
                 if reg_int = usartbaud_addr then
@@ -214,53 +356,66 @@ begin
                     -- A write to the status register
                     usartstat_int <= I_datain;
                 elsif reg_int = usartdata_addr then
-                    -- A write to the data register triggers a transmission
-                    -- Signal start
-                    txstart <= '1';
-                    -- Load transmit buffer with 7/8/9 data bits, parity bit and
-                    -- a start bit
-                    -- Stop bits will be automatically added since the remaining
-                    -- bits are set to 1. Most right bit is start bit.
-                    txbuffer <= (others => '1');
-                    if usartctrl_int(3 downto 2) = "10" then
-                        -- 9 bits data
-                        txbuffer(9 downto 0) <= I_datain(8 downto 0) & '0';
-                        -- Have parity
-                        if usartctrl_int(5) = '1' then
-                            txbuffer(10) <= I_datain(8) xor I_datain(7) xor I_datain(6) xor I_datain(5) xor I_datain(4)
-                                            xor I_datain(3) xor I_datain(2) xor I_datain(1) xor I_datain(0) xor usartctrl_int(4);
-                        end if;
-                    elsif usartctrl_int(3 downto 2) = "11" then
-                        -- 7 bits data
-                        txbuffer(7 downto 0) <= I_datain(6 downto 0) & '0';
-                        -- Have parity
-                        if usartctrl_int(5) = '1' then
-                            txbuffer(8) <= I_datain(6) xor I_datain(5) xor I_datain(4) xor I_datain(3)
-                                         xor I_datain(2) xor I_datain(1) xor I_datain(0) xor usartctrl_int(4);
+                    if fifoenable = '1' then
+                        -- A write to the data register fills the FIFO,
+                        -- only once for a retired store, dropped if full
+                        if I_instret = '1' and txlevel /= usart_fifo_size then
+                            txpush := true;
+                            txfifo(to_integer(txhead(usart_fifo_size_bits-1 downto 0))) <= I_datain(8 downto 0);
+                            txhead <= txhead + 1;
+                            -- Signal that we are sending
+                            usartstat_int(4) <= '0';
                         end if;
                     else
-                        -- 8 bits data
-                        txbuffer(8 downto 0) <= I_datain(7 downto 0) & '0';
-                        -- Have parity
-                        if usartctrl_int(5) = '1' then
-                            txbuffer(9) <= I_datain(7) xor I_datain(6) xor I_datain(5) xor I_datain(4) xor I_datain(3)
-                                         xor I_datain(2) xor I_datain(1) xor I_datain(0) xor usartctrl_int(4);
-                        end if;
+                        -- A write to the data register triggers a transmission
+                        -- Signal start
+                        txstart <= '1';
+                        -- Load transmit buffer
+                        txbuffer <= txframe(I_datain(8 downto 0), usartctrl_int);
+                        -- Signal that we are sending
+                        usartstat_int(4) <= '0'; 
                     end if;
-                    -- Signal that we are sending
-                    usartstat_int(4) <= '0'; 
                 end if;
             end if;
             
+            -- Receive timeout, counts bit times while bytes are
+            -- waiting in the FIFO and nothing is received
+            if fifoenable = '0' or rxlevel = 0 or rxstate /= rx_idle then
+                rxtobittimer <= to_integer(unsigned(usartbaud_int));
+                rxtocount <= 0;
+            elsif rxtobittimer > 0 then
+                rxtobittimer <= rxtobittimer - 1;
+            elsif rxtocount < 40 then
+                rxtobittimer <= to_integer(unsigned(usartbaud_int));
+                rxtocount <= rxtocount + 1;
+            else
+                -- Signal receive timeout
+                usartstat_int(5) <= '1';
+            end if;
+
             -- If data register is read...
             if isword and I_csio = '1' and I_wren = '0' then
                 if reg_int = usartdata_addr then
-                    -- Clear the received status bits
-                    -- PE, RC, RF, FE
-                    usartstat_int(3) <= '0';
-                    usartstat_int(2) <= '0';
-                    usartstat_int(1) <= '0';
-                    usartstat_int(0) <= '0';
+                    if fifoenable = '1' then
+                        -- Remove the byte from the FIFO, only once for
+                        -- a retired load. Restart the receive timeout
+                        if I_instret = '1' and rxfifo_valid = '1' then
+                            rxpop := true;
+                            rxtail <= rxtail + 1;
+                            rxtocount <= 0;
+                            usartstat_int(5) <= '0';
+                            usartstat_int(3) <= '0';
+                            usartstat_int(1) <= '0';
+                            usartstat_int(0) <= '0';
+                        end if;
+                    else
+                        -- Clear the received status bits
+                        -- PE, RC, RF, FE
+                        usartstat_int(3) <= '0';
+                        usartstat_int(2) <= '0';
+                        usartstat_int(1) <= '0';
+                        usartstat_int(0) <= '0';
+                    end if;
                 end if;
             end if;
             
@@ -283,9 +438,19 @@ begin
                         -- Add up posibly parity bit and posibly second stop bit
                         txshiftcounter <= txshiftcounter_var + to_integer(unsigned(usartctrl_int(5 downto 5))) + to_integer(unsigned(usartctrl_int(0 downto 0)));
                         txstate <= tx_iter;
+                    elsif fifoenable = '1' and txlevel /= 0 then
+                        -- Next byte from the FIFO
+                        txstate <= tx_load;
                     else
                         txstate <= tx_idle;
                     end if;
+                -- Load the transmit buffer from the FIFO
+                when tx_load =>
+                    O_TxD <= '1';
+                    txbuffer <= txframe(txfifo_q, usartctrl_int);
+                    txtail <= txtail + 1;
+                    txstart <= '1';
+                    txstate <= tx_idle;
                 -- Transmit the bits
                 when tx_iter =>
                     -- Cycle trough all bits in the transmit buffer
@@ -305,8 +470,11 @@ begin
                 when tx_ready =>
                     O_TxD <= '1';
                     txstate <= tx_idle;
-                    -- Signal character transmitted
-                    usartstat_int(4) <= '1'; 
+                    -- Signal character transmitted, with the FIFO
+                    -- enabled only if the FIFO is empty
+                    if fifoenable = '0' or (txlevel = 0 and not txpush) then
+                        usartstat_int(4) <= '1';
+                    end if;
                 when others =>
                     O_TxD <= '1';
                     txstate <= tx_idle;
@@ -415,20 +583,37 @@ begin
                         -- Signal frame error
                         usartstat_int(0) <= '1';
                     end if;
-                    -- Any way, copy the received data to the data register
-                    usartdata_int <= (others => '0');
+                    rxdata := (others => '0');
                     if usartctrl_int(3 downto 2) = "10" then
                         -- 9 bits
-                        usartdata_int(8 downto 0) <= rxbuffer(8 downto 0);
+                        rxdata(8 downto 0) := rxbuffer(8 downto 0);
                     elsif usartctrl_int(3 downto 2) = "11" then
                         -- 7 bits
-                        usartdata_int(6 downto 0) <= rxbuffer(6 downto 0);
+                        rxdata(6 downto 0) := rxbuffer(6 downto 0);
                     else
                         -- 8 bits
-                        usartdata_int(7 downto 0) <= rxbuffer(7 downto 0);
+                        rxdata(7 downto 0) := rxbuffer(7 downto 0);
+                    end if;
+                    if loadenable_int = '1' then
+                        -- The hardware loader takes the byte, the
+                        -- processor does not see it
+                        O_rxdata <= rxbuffer(7 downto 0);
+                        O_rxvalid <= '1';
+                    elsif fifoenable = '1' then
+                        -- Put the byte in the FIFO, signal overrun if full
+                        if rxlevel = usart_fifo_size then
+                            usartstat_int(6) <= '1';
+                        else
+                            rxfifo(to_integer(rxhead(usart_fifo_size_bits-1 downto 0))) <= rxdata;
+                            rxhead <= rxhead + 1;
+                        end if;
+                    else
+                        -- Any way, copy the received data to the data register
+                        usartdata_int <= (others => '0');
+                        usartdata_int(8 downto 0) <= rxdata;
+                        -- signal reception
+                        usartstat_int(2) <= '1';
                     end if;
-                    -- signal reception
-                    usartstat_int(2) <= '1';
                     rxstate <= rx_idle;
                 -- Wrong start bit detected, no data present
                 when rx_fail =>
@@ -438,8 +623,56 @@ begin
                 when others =>
                     rxstate <= rx_idle;
             end case;
+
+            -- Read the oldest entry of the receive FIFO. On a pop,
+            -- read the entry after it, so that the next read of the
+            -- data register, even in the next cycle, returns the next
+            -- byte. The entry is valid if it was written before this
+            -- cycle, a pop is held off until then
+            if rxpop then
+                rxnext := rxtail + 1;
+            else
+                rxnext := rxtail;
+            end if;
+            rxfifo_q <= rxfifo(to_integer(rxnext(usart_fifo_size_bits-1 downto 0)));
+            if rxhead /= rxnext then
+                rxfifo_valid <= '1';
+            else
+                rxfifo_valid <= '0';
+            end if;
+
+            -- Disabling the FIFOs empties them
+            if fifoenable = '0' then
+                txhead <= (others => '0');
+                txtail <= (others => '0');
+                rxhead <= (others => '0');
+                rxtail <= (others => '0');
+            end if;
         end if;
     end process;
+
+    -- FIFO levels and flags
+    fifoenable <= usartctrl_int(8);
+    txlevel <= txhead - txtail;
+    rxlevel <= rxhead - rxtail;
+    rxthreshold <= '1' when fifoenable = '1' and rxlevel /= 0 and
+                            resize(rxlevel, 8) >= unsigned(usartctrl_int(23 downto 16)) else '0';
+    txthreshold <= '1' when fifoenable = '1' and
+                            resize(txlevel, 8) <= unsigned(usartctrl_int(31 downto 24)) else '0';
+
+    -- The data register returns the oldest byte of the receive FIFO
+    usartdata_read <= std_logic_vector(resize(unsigned(rxfifo_q), 32)) when fifoenable = '1' else usartdata_int;
+    -- With the FIFO enabled, RC is set if the receive FIFO is not empty
+    usartstat_read(31 downto 24) <= std_logic_vector(resize(txlevel, 8));
+    usartstat_read(23 downto 16) <= std_logic_vector(resize(rxlevel, 8));
+    usartstat_read(15 downto 10) <= (others => '0');
+    usartstat_read(9) <= txthreshold;
+    usartstat_read(8) <= rxthreshold;
+    usartstat_read(7) <= '1' when txlevel = usart_fifo_size else '0';
+    usartstat_read(6 downto 3) <= usartstat_int(6 downto 3);
+    usartstat_read(2) <= usartstat_int(2) when fifoenable = '0' else
+                         '1' when rxlevel /= 0 else '0';
+    usartstat_read(1 downto 0) <= usartstat_int(1 downto 0);
     
     -- TIMER1 - a very simple timer
     process (I_clk, I_areset) is
@@ -548,9 +781,13 @@ begin
     -- O_intrio(7) is set by the System Timer
 
     -- USART receive or transmit interrupt. Software must determine if it was
-    -- receive or transmit or both
+    -- receive or transmit or both. With the FIFOs, also the thresholds and
+    -- the receive timeout
     O_intrio(18) <= '1' when (usartstat_int(4) = '1' and usartctrl_int(7) = '1') or
-                             (usartstat_int(2) = '1' and usartctrl_int(6) = '1') else '0';
+                             (usartstat_read(2) = '1' and usartctrl_int(6) = '1') or
+                             (rxthreshold = '1' and usartctrl_int(9) = '1') or
+                             (txthreshold = '1' and usartctrl_int(10) = '1') or
+                             (usartstat_int(5) = '1' and usartctrl_int(11) = '1') else '0';
     -- TIMER1 compare match interrupt
     O_intrio(17) <= '1' when timer1ctrl_int(4) = '1' and timer1stat_int(4) = '1' else '0';
     -- This next interrupt is for testing only, will be removed
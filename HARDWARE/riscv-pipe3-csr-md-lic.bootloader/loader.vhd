@@ -0,0 +1,299 @@
+--
+-- This file is part of the THUAS RISC-V Minimal Project
+--
+-- (c)2022, Jesse E.J. op den Brouw <J.E.J.opdenBrouw@hhs.nl>
+--
+-- loader.vhd - Hardware S-record loader
+
+-- This hardware description is for educational purposes only.
+-- This hardware description is distributed in the hope that it
+-- will be useful, but WITHOUT ANY WARRANTY; without even the
+-- implied warranty of MERCHANTABILITY or FITNESS FOR A
+-- PARTICULAR PURPOSE.
+
+-- The hardware loader decodes S-records received by the UART
+-- and writes the data straight into the ROM, without the
+-- processor. While the loader is enabled (LOADCTRL bit 0), the
+-- UART hands all received bytes to the loader instead of the
+-- data register. The bytes of a word are collected and the
+-- word is written with a read-modify-write through the data
+-- port of the ROM, so records need not be word aligned. A byte
+-- takes at least 160 clock cycles on the line, the write takes
+-- three, so the loader keeps up at any baud rate.
+--
+-- S1, S2 and S3 records are written to the ROM, S7, S8 and S9
+-- records end the load and set the start address. Other
+-- records are checked and skipped. The UART must be set to 8
+-- data bits. The processor must not access the ROM while the
+-- loader is enabled.
+--
+-- LOADSTAT bits:
+--   0: end record received, loading is done
+--   1: checksum error
+--   2: format error (not a hex digit, count too small)
+--   3: data outside the ROM, not written
+--   4: loader is enabled
+-- LOADCNT holds the number of bytes written and LOADSTART
+-- the start address of the end record. All are cleared
+-- when the loader is enabled.
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library work;
+use work.processor_common.all;
+
+entity loader is
+    port (I_clk : in std_logic;
+          I_areset : in std_logic;
+          -- From the UART
+          I_enable : in std_logic;
+          I_rxdata : in std_logic_vector(7 downto 0);
+          I_rxvalid : in std_logic;
+          -- To the ROM, data in ROM (Big Endian) format
+          O_romaddress : out data_type;
+          O_romwren : out std_logic;
+          O_romdataout : out data_type;
+          I_romdatain : in data_type;
+          -- Status for the processor
+          O_stat : out data_type;
+          O_count : out data_type;
+          O_start : out data_type
+         );
+end entity loader;
+
+architecture rtl of loader is
+-- Parsing the S-records
+type loaderstate_type is (ld_idle, ld_type, ld_count, ld_address, ld_data, ld_checksum, ld_done);
+signal state : loaderstate_type;
+-- First hex digit of a byte received
+signal havenibble : std_logic;
+signal nibble : std_logic_vector(3 downto 0);
+-- Record type: data record, end record
+signal isdata : std_logic;
+signal isend : std_logic;
+-- Address bytes still to go and bytes left in the record
+signal addrleft : integer range 0 to 4;
+signal remain : integer range 0 to 255;
+signal sum : unsigned(7 downto 0);
+signal address : unsigned(31 downto 0);
+-- The word being collected, one mask bit per byte
+signal wordaddress : std_logic_vector(31 downto 0);
+signal wordbuf : data_type;
+signal wordmask : std_logic_vector(3 downto 0);
+-- Writing a word: read the ROM, then merge and write
+type flushstate_type is (fl_none, fl_read, fl_merge);
+signal flush : flushstate_type;
+-- Status
+signal enable_prev : std_logic;
+signal done : std_logic;
+signal checksumerror : std_logic;
+signal formaterror : std_logic;
+signal rangeerror : std_logic;
+signal count : unsigned(31 downto 0);
+signal start : data_type;
+
+-- Value of a hex digit, 16 if not a hex digit
+function hexvalue(c : std_logic_vector(7 downto 0)) return integer is
+variable v : integer range 0 to 255;
+begin
+    v := to_integer(unsigned(c));
+    if v >= 48 and v <= 57 then
+        return v - 48;
+    elsif v >= 65 and v <= 70 then
+        return v - 55;
+    elsif v >= 97 and v <= 102 then
+        return v - 87;
+    else
+        return 16;
+    end if;
+end function hexvalue;
+
+begin
+
+    process (I_clk, I_areset) is
+    variable digit : integer range 0 to 16;
+    variable byte : unsigned(7 downto 0);
+    variable merged : data_type;
+    begin
+        if I_areset = '1' then
+            state <= ld_idle;
+            havenibble <= '0';
+            nibble <= (others => '0');
+            isdata <= '0';
+            isend <= '0';
+            addrleft <= 0;
+            remain <= 0;
+            sum <= (others => '0');
+            address <= (others => '0');
+            wordaddress <= (others => '0');
+            wordbuf <= (others => '0');
+            wordmask <= (others => '0');
+            flush <= fl_none;
+            enable_prev <= '0';
+            done <= '0';
+            checksumerror <= '0';
+            formaterror <= '0';
+            rangeerror <= '0';
+            count <= (others => '0');
+            start <= (others => '0');
+            O_romwren <= '0';
+            O_romdataout <= (others => '0');
+        elsif rising_edge(I_clk) then
+            -- Default no write
+            O_romwren <= '0';
+            enable_prev <= I_enable;
+
+            -- Write the collected word. The ROM data is
+            -- available two clocks after the read starts
+            case flush is
+                when fl_read =>
+                    flush <= fl_merge;
+                when fl_merge =>
+                    merged := I_romdatain;
+                    for i in 0 to 3 loop
+                        if wordmask(i) = '1' then
+                            merged(31-8*i downto 24-8*i) := wordbuf(31-8*i downto 24-8*i);
+                        end if;
+                    end loop;
+                    O_romdataout <= merged;
+                    O_romwren <= '1';
+                    wordmask <= (others => '0');
+                    flush <= fl_none;
+                when others =>
+                    flush <= fl_none;
+            end case;
+
+            if I_enable = '0' then
+                state <= ld_idle;
+            elsif enable_prev = '0' then
+                -- Just enabled, start afresh
+                state <= ld_idle;
+                havenibble <= '0';
+                wordmask <= (others => '0');
+                done <= '0';
+                checksumerror <= '0';
+                formaterror <= '0';
+                rangeerror <= '0';
+                count <= (others => '0');
+                start <= (others => '0');
+            elsif I_rxvalid = '1' then
+                digit := hexvalue(I_rxdata);
+                case state is
+                    -- Wait for the S, skips line ends
+                    when ld_idle =>
+                        if I_rxdata = x"53" then
+                            state <= ld_type;
+                        end if;
+                    -- Record type, sets the number of address bytes
+                    when ld_type =>
+                        isdata <= '0';
+                        isend <= '0';
+                        havenibble <= '0';
+                        state <= ld_count;
+                        case I_rxdata is
+                            when x"31" => addrleft <= 2; isdata <= '1';
+                            when x"32" => addrleft <= 3; isdata <= '1';
+                            when x"33" => addrleft <= 4; isdata <= '1';
+                            when x"37" => addrleft <= 4; isend <= '1';
+                            when x"38" => addrleft <= 3; isend <= '1';
+                            when x"39" => addrleft <= 2; isend <= '1';
+                            when x"30" | x"35" => addrleft <= 2;
+                            when x"36" => addrleft <= 3;
+                            -- S4 is reserved, skip it
+                            when others => state <= ld_idle;
+                        end case;
+                    -- Already done, ignore the rest
+                    when ld_done =>
+                        null;
+                    -- Hex digits of count, address, data and checksum
+                    when others =>
+                        if digit = 16 then
+                            -- Not a hex digit, wait for the next record
+                            formaterror <= '1';
+                            state <= ld_idle;
+                        elsif havenibble = '0' then
+                            nibble <= std_logic_vector(to_unsigned(digit, 4));
+                            havenibble <= '1';
+                        else
+                            havenibble <= '0';
+                            byte := unsigned(nibble) & to_unsigned(digit, 4);
+                            sum <= sum + byte;
+                            case state is
+                                when ld_count =>
+                                    -- Count holds address, data and checksum
+                                    if to_integer(byte) < addrleft + 1 then
+                                        formaterror <= '1';
+                                        state <= ld_idle;
+                                    else
+                                        sum <= byte;
+                                        remain <= to_integer(byte);
+                                        address <= (others => '0');
+                                        state <= ld_address;
+                                    end if;
+                                when ld_address =>
+                                    address <= address(23 downto 0) & byte;
+                                    addrleft <= addrleft - 1;
+                                    remain <= remain - 1;
+                                    if addrleft = 1 then
+                                        if remain = 2 then
+                                            state <= ld_checksum;
+                                        else
+                                            state <= ld_data;
+                                        end if;
+                                    end if;
+                                when ld_data =>
+                                    if isdata = '1' then
+                                        if address(31 downto rom_size_bits) /= 0 then
+                                            rangeerror <= '1';
+                                        else
+                                            -- Collect the byte, write a full word
+                                            wordaddress <= std_logic_vector(address);
+                                            case address(1 downto 0) is
+                                                when "00" => wordbuf(31 downto 24) <= std_logic_vector(byte); wordmask(0) <= '1';
+                                                when "01" => wordbuf(23 downto 16) <= std_logic_vector(byte); wordmask(1) <= '1';
+                                                when "10" => wordbuf(15 downto 8) <= std_logic_vector(byte); wordmask(2) <= '1';
+                                                when others => wordbuf(7 downto 0) <= std_logic_vector(byte); wordmask(3) <= '1';
+                                                               flush <= fl_read;
+                                            end case;
+                                            count <= count + 1;
+                                        end if;
+                                    end if;
+                                    address <= address + 1;
+                                    remain <= remain - 1;
+                                    if remain = 2 then
+                                        state <= ld_checksum;
+                                    end if;
+                                when ld_checksum =>
+                                    if sum + byte /= 255 then
+                                        checksumerror <= '1';
+                                    end if;
+                                    -- Write the last part of a word
+                                    if wordmask /= "0000" then
+                                        flush <= fl_read;
+                                    end if;
+                                    if isend = '1' then
+                                        start <= std_logic_vector(address);
+                                        done <= '1';
+                                        state <= ld_done;
+                                    else
+                                        state <= ld_idle;
+                                    end if;
+                                when others =>
+                                    state <= ld_idle;
+                            end case;
+                        end if;
+                end case;
+            end if;
+        end if;
+    end process;
+
+    -- The ROM decodes the word address
+    O_romaddress <= wordaddress;
+
+    O_stat <= (4 => I_enable, 3 => rangeerror, 2 => formaterror, 1 => checksumerror, 0 => done, others => '0');
+    O_count <= std_logic_vector(count);
+    O_start <= start;
+
+end architecture rtl;
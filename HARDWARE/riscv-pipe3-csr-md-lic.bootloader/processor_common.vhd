@@ -46,6 +46,9 @@ package processor_common is
     -- Do we have a boot ROM?
     constant HAVE_BOOT_ROM : boolean := TRUE;
     
+    -- Do we have the hardware S-record loader? See loader.vhd
+    constant HAVE_LOADER : boolean := TRUE;
+    
     -- The common data type is 32 bits wide
     subtype data_type is std_logic_vector(31 downto 0);
     
@@ -107,17 +110,27 @@ package processor_common is
     constant rom_size : integer := 2**(rom_size_bits-2);
     type rom_type is array(0 to rom_size-1) of data_type;
     -- The contents of the ROM is loaded by processor_common_rom.vhd
+    -- If set, the contents is read from this data file instead,
+    -- made with srec2vhdl -t. The file is read at elaboration.
+    constant rom_init_file : string := "";
+    -- If set, Quartus initializes the ROM from this MIF file,
+    -- made with srec2mif -w -s <rom_size_bits>. The contents
+    -- can then be updated without synthesis, see update-mif.
+    constant rom_mif_file : string := "";
     
     -- The bootloader ROM
     -- NOTE: the bootloader ROM is word (32 bits) size.
     -- NOTE: data is in Little Endian format (as by the toolchain)
     --       for half word and word entities
     --       Set bootloader rom_size_bits as if it were bytes
-    --       default is 4 kB data
-    constant bootloader_size_bits : integer := 12;
+    --       default is 8 kB data
+    constant bootloader_size_bits : integer := 13;
     constant bootloader_size : integer := 2**(bootloader_size_bits-2);
     type bootloader_type is array(0 to bootloader_size-1) of data_type;
     -- The contents of the bootloader ROM is loaded by bootloader.vhd
+    -- If set, Quartus initializes the bootloader ROM from this
+    -- MIF file, made with srec2mif -w -s <bootloader_size_bits>
+    constant bootloader_mif_file : string := "";
     
     -- The RAM
     -- NOTE: the RAM is 4x byte (8 bits) size, supporting
@@ -129,6 +142,10 @@ package processor_common is
     constant ram_size : integer := 2**(ram_size_bits-2);
     -- The type of the RAM block
     type ram_type is array (0 to ram_size-1) of std_logic_vector(7 downto 0);
+    -- If set, the RAM is preloaded from this data file, made
+    -- with srec2vhdl -t -w from the initialized data. The file
+    -- is read at elaboration.
+    constant ram_init_file : string := "";
                         
     -- The I/O
     -- NOTE: the I/O is word (32 bits) size, Big Endian
@@ -139,6 +156,12 @@ package processor_common is
     constant io_size_bits : integer := 8;
     constant io_size : integer := 2**(io_size_bits-2);
     type io_type is array (0 to io_size-1) of data_type;
+    -- The USART transmit and receive FIFOs, used when enabled
+    -- in the USART control register. 4 gives 16 entries, 6
+    -- gives 64 entries. The FIFOs fit in block RAM
+    constant usart_fifo_size_bits : integer := 4;
+    constant usart_fifo_size : integer := 2**usart_fifo_size_bits;
+    type usart_fifo_type is array (0 to usart_fifo_size-1) of std_logic_vector(8 downto 0);
     
     -- The Control and Status Registers
     -- Keep csr_size_bits to 12!!!
@@ -110,6 +110,12 @@ component rom is
           O_instr : out data_type;
           I_datain : in data_type;
           O_data_out : out data_type;
+          -- Hardware loader
+          I_ldactive : in std_logic;
+          I_ldaddress : in data_type;
+          I_ldwren : in std_logic;
+          I_lddatain : in data_type;
+          O_lddataout : out data_type;
           --
           O_instruction_misaligned_error : out std_logic;
           O_load_misaligned_error : out std_logic;
@@ -167,9 +173,36 @@ component io is
           O_intrio : out data_type;
           -- TIME and TIMEH
           O_time : out data_type;
-          O_timeh : out data_type
+          O_timeh : out data_type;
+          -- Hardware loader
+          O_loadenable : out std_logic;
+          O_rxdata : out std_logic_vector(7 downto 0);
+          O_rxvalid : out std_logic;
+          I_loadstat : in data_type;
+          I_loadcount : in data_type;
+          I_loadstart : in data_type;
+          -- Instruction retired, for the USART FIFOs
+          I_instret : in std_logic
          );
 end component io;
+component loader is
+    port (I_clk : in std_logic;
+          I_areset : in std_logic;
+          -- From the UART
+          I_enable : in std_logic;
+          I_rxdata : in std_logic_vector(7 downto 0);
+          I_rxvalid : in std_logic;
+          -- To the ROM, data in ROM (Big Endian) format
+          O_romaddress : out data_type;
+          O_romwren : out std_logic;
+          O_romdataout : out data_type;
+          I_romdatain : in data_type;
+          -- Status for the processor
+          O_stat : out data_type;
+          O_count : out data_type;
+          O_start : out data_type
+         );
+end component loader;
 component csr is
     port (I_clk : in std_logic;
           I_areset : in std_logic;
@@ -290,6 +323,17 @@ signal csboot_int : std_logic;
 signal bootinstr_int : data_type;
 signal bootdatain_int : data_type;
 
+signal loadenable_int : std_logic;
+signal loadrxdata_int : std_logic_vector(7 downto 0);
+signal loadrxvalid_int : std_logic;
+signal loadaddress_int : data_type;
+signal loadwren_int : std_logic;
+signal loaddataout_int : data_type;
+signal loaddatain_int : data_type;
+signal loadstat_int : data_type;
+signal loadcount_int : data_type;
+signal loadstart_int : data_type;
+
 begin
 
     clk_int <= I_clk;
@@ -369,6 +413,11 @@ begin
               O_instr => rominstr_int,
               I_datain => dataout_int,
               O_data_out => romdatain_int,
+              I_ldactive => loadenable_int,
+              I_ldaddress => loadaddress_int,
+              I_ldwren => loadwren_int,
+              I_lddatain => loaddataout_int,
+              O_lddataout => loaddatain_int,
               O_instruction_misaligned_error => instruction_misaligned_error_int,
               O_load_misaligned_error => load_misaligned_error_int(3),
               O_store_misaligned_error => open
@@ -421,9 +470,42 @@ begin
               O_TxD => O_TxD,
               O_intrio => intrio_int,
               O_time => time_int,
-              O_timeh => timeh_int
+              O_timeh => timeh_int,
+              O_loadenable => loadenable_int,
+              O_rxdata => loadrxdata_int,
+              O_rxvalid => loadrxvalid_int,
+              I_loadstat => loadstat_int,
+              I_loadcount => loadcount_int,
+              I_loadstart => loadstart_int,
+              I_instret => instret_int
              );
 
+    -- The hardware loader writes the ROM without the processor
+    gen_loader: if HAVE_LOADER generate
+        loader0: loader
+        port map (I_clk => clk_int,
+                  I_areset => areset_int,
+                  I_enable => loadenable_int,
+                  I_rxdata => loadrxdata_int,
+                  I_rxvalid => loadrxvalid_int,
+                  O_romaddress => loadaddress_int,
+                  O_romwren => loadwren_int,
+                  O_romdataout => loaddataout_int,
+                  I_romdatain => loaddatain_int,
+                  O_stat => loadstat_int,
+                  O_count => loadcount_int,
+                  O_start => loadstart_int
+                 );
+    end generate;
+    gen_loader_not: if not HAVE_LOADER generate
+        loadaddress_int <= (others => '0');
+        loadwren_int <= '0';
+        loaddataout_int <= (others => '0');
+        loadstat_int <= (others => '0');
+        loadcount_int <= (others => '0');
+        loadstart_int <= (others => '0');
+    end generate;
+
     csr0: csr
     port map (I_clk => clk_int,
               I_areset => areset_int,
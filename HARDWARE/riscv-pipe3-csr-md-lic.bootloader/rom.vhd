@@ -15,11 +15,15 @@
 -- is placed in mutable onboard RAM blocks and can be changed
 -- by writing to it. A read takes two clock cycles, for both
 -- instruction and data. The ROM contents is placed in file
--- processor_common_rom.vhd.
+-- processor_common_rom.vhd or is read from the data file
+-- rom_init_file. While the hardware loader is active, the
+-- data port is used by the loader, with data in ROM format.
 
 library ieee;
 use ieee.std_logic_1164.all;
 use ieee.numeric_std.all;
+use ieee.std_logic_textio.all;
+use std.textio.all;
 
 library work;
 use work.processor_common.all;
@@ -37,6 +41,12 @@ entity rom is
           O_instr : out data_type;
           I_datain : in data_type;
           O_data_out : out data_type;
+          -- Hardware loader
+          I_ldactive : in std_logic;
+          I_ldaddress : in data_type;
+          I_ldwren : in std_logic;
+          I_lddatain : in data_type;
+          O_lddataout : out data_type;
           --
           O_instruction_misaligned_error : out std_logic;
           O_load_misaligned_error : out std_logic;
@@ -46,15 +56,48 @@ end entity rom;
 
 architecture rtl of rom is
 
+-- Read the ROM contents from a data file made by srec2vhdl -t.
+-- Every line holds an element index and a hex value.
+impure function read_rom_file(name : string) return rom_type is
+file romfile : text open read_mode is name;
+variable l : line;
+variable index : integer;
+variable value : data_type;
+variable contents : rom_type := (others => (others => '0'));
+begin
+    while not endfile(romfile) loop
+        readline(romfile, l);
+        read(l, index);
+        hread(l, value);
+        if index < rom_size then
+            contents(index) := value;
+        end if;
+    end loop;
+    return contents;
+end function read_rom_file;
+
+-- Use the data file if there is one
+impure function init_rom return rom_type is
+begin
+    if rom_init_file = "" then
+        return rom_contents;
+    else
+        return read_rom_file(rom_init_file);
+    end if;
+end function init_rom;
+
 -- The ROM itself
-signal rom : rom_type := rom_contents;
+signal rom : rom_type := init_rom;
+-- Quartus initializes the ROM from a MIF file, if set
+attribute ram_init_file : string;
+attribute ram_init_file of rom : signal is rom_mif_file;
 
 begin
 
     O_instruction_misaligned_error <= '0' when I_pc(1 downto 0) = "00" else '1';        
 
     -- ROM, for both instructions and read-write data
-    process (I_clk, I_areset, I_pc, I_address, I_csrom, I_size, I_wren, I_datain) is
+    process (I_clk, I_areset, I_pc, I_address, I_csrom, I_size, I_wren, I_datain, I_ldactive, I_ldaddress) is
     variable address_instr : integer range 0 to rom_size-1;
     variable address_data : integer range 0 to rom_size-1;
     variable instr_var : data_type;
@@ -64,7 +107,11 @@ begin
     begin
         -- Calculate addresses
         address_instr := to_integer(unsigned(I_pc(rom_size_bits-1 downto 2)));
-        address_data := to_integer(unsigned(I_address(rom_size_bits-1 downto 2)));
+        if I_ldactive = '1' then
+            address_data := to_integer(unsigned(I_ldaddress(rom_size_bits-1 downto 2)));
+        else
+            address_data := to_integer(unsigned(I_address(rom_size_bits-1 downto 2)));
+        end if;
  
         -- Set store misaligned error
         if I_csrom = '1' and I_wren = '1' and I_size /= size_word then
@@ -81,12 +128,19 @@ begin
             end if;
             -- Read the data
             romdata_var := rom(address_data);
-            -- Write the ROM
-            if I_wren = '1' and I_size = size_word then
+            -- Write the ROM, by the loader or the processor
+            if I_ldactive = '1' then
+                if I_ldwren = '1' then
+                    rom(address_data) <= I_lddatain;
+                end if;
+            elsif I_wren = '1' and I_size = size_word then
                 rom(address_data) <= I_datain(7 downto 0) & I_datain(15 downto 8) & I_datain(23 downto 16) & I_datain(31 downto 24);
             end if;
         end if;
 
+        -- Data for the loader, not recoded
+        O_lddataout <= romdata_var;
+
         -- Recode instruction
         O_instr <= instr_var(7 downto 0) & instr_var(15 downto 8) & instr_var(23 downto 16) & instr_var(31 downto 24);
         
@@ -0,0 +1,398 @@
+--
+-- This file is part of the THUAS RISC-V Minimal Project
+--
+-- (c)2022, Jesse E.J. op den Brouw <J.E.J.opdenBrouw@hhs.nl>
+--
+-- tb_usart_fifo.vhd - VHDL Test Bench file for the USART FIFOs
+
+-- This hardware description is for educational purposes only.
+-- This hardware description is distributed in the hope that it
+-- will be useful, but WITHOUT ANY WARRANTY; without even the
+-- implied warranty of MERCHANTABILITY or FITNESS FOR A
+-- PARTICULAR PURPOSE.
+
+-- The I/O unit is tested on its own, TxD is looped back to RxD.
+-- Loads take two cycles with instret set in the second cycle,
+-- stores take one cycle, as with the core. The test bench checks
+-- the FIFO levels, back-to-back reads of the data register, the
+-- wrap around of the FIFO pointers, the receive overrun, the TXT
+-- level interrupt and the emptying of the FIFOs by clearing FEN.
+-- Then loads that retire in consecutive cycles, a stalled load,
+-- a load and a store that do not retire, a load in the cycle in
+-- which a byte enters the empty receive FIFO and a store that
+-- does not retire in the cycle in which the last byte is sent.
+-- The last two sweep a delay over 40 cycles, so that both
+-- coincide once. Errors are reported with severity error, the
+-- simulation ends with a note.
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library work;
+use work.processor_common.all;
+
+entity tb_usart_fifo is
+end entity tb_usart_fifo;
+
+architecture sim of tb_usart_fifo is
+
+component io is
+    generic (freq_sys : integer := SYSTEM_FREQUENCY;
+             freq_count : integer := CLOCK_FREQUENCY
+         );
+    port (I_clk : in std_logic;
+          I_areset : in std_logic;
+          I_csio : in std_logic;
+          I_address : in data_type;
+          I_size : size_type;
+          I_wren : in std_logic;
+          I_datain : in data_type;
+          O_dataout : out data_type;
+          O_load_misaligned_error : out std_logic;
+          O_store_misaligned_error : out std_logic;
+          I_pina : in data_type;
+          O_pouta : out data_type;
+          I_RxD : in std_logic;
+          O_TxD : out std_logic;
+          O_intrio : out data_type;
+          O_time : out data_type;
+          O_timeh : out data_type;
+          O_loadenable : out std_logic;
+          O_rxdata : out std_logic_vector(7 downto 0);
+          O_rxvalid : out std_logic;
+          I_loadstat : in data_type;
+          I_loadcount : in data_type;
+          I_loadstart : in data_type;
+          I_instret : in std_logic
+         );
+end component io;
+
+signal clk : std_logic;
+signal areset : std_logic;
+signal csio : std_logic;
+signal address : data_type;
+signal wren : std_logic;
+signal datain : data_type;
+signal dataout : data_type;
+signal intrio : data_type;
+signal instret : std_logic;
+signal TxD : std_logic;
+signal zero : data_type := (others => '0');
+signal finished : boolean := false;
+
+-- Registers of the USART, word addresses
+constant usartdata_addr : integer := 8;
+constant usartbaud_addr : integer := 9;
+constant usartctrl_addr : integer := 10;
+constant usartstat_addr : integer := 11;
+-- FEN in USARTCTRL, 8 data bits, no parity, one stop bit
+constant fen : data_type := x"00000100";
+-- Baud rate register, 10 clock cycles per bit
+constant baud : data_type := x"00000009";
+
+begin
+
+    -- Instantiate the I/O, TxD is looped back to RxD
+    dut : io
+    port map (I_clk => clk, I_areset => areset, I_csio => csio, I_address => address,
+              I_size => size_word, I_wren => wren, I_datain => datain, O_dataout => dataout,
+              O_load_misaligned_error => open, O_store_misaligned_error => open,
+              I_pina => zero, O_pouta => open, I_RxD => TxD, O_TxD => TxD,
+              O_intrio => intrio, O_time => open, O_timeh => open,
+              O_loadenable => open, O_rxdata => open, O_rxvalid => open,
+              I_loadstat => zero, I_loadcount => zero,
+              I_loadstart => zero, I_instret => instret);
+
+    -- Generate a symmetric clock signal, 50 MHz
+    process is
+    begin
+        if finished then
+            wait;
+        end if;
+        clk <= '1';
+        wait for 10 ns;
+        clk <= '0';
+        wait for 10 ns;
+    end process;
+
+    -- The bus cycles of the core and the checks
+    process is
+    variable data : data_type;
+    variable value : data_type;
+    variable count : integer;
+    variable hits : integer;
+    variable misses : integer;
+
+    -- Store to a register, one cycle
+    procedure write_reg(reg : in integer; value : in data_type) is
+    begin
+        csio <= '1';
+        wren <= '1';
+        address <= std_logic_vector(to_unsigned(reg*4, 32));
+        datain <= value;
+        instret <= '1';
+        wait until falling_edge(clk);
+        csio <= '0';
+        wren <= '0';
+        instret <= '0';
+    end procedure;
+
+    -- Store to a register that does not retire, one cycle
+    procedure write_reg_cancel(reg : in integer; value : in data_type) is
+    begin
+        csio <= '1';
+        wren <= '1';
+        address <= std_logic_vector(to_unsigned(reg*4, 32));
+        datain <= value;
+        instret <= '0';
+        wait until falling_edge(clk);
+        csio <= '0';
+        wren <= '0';
+    end procedure;
+
+    -- Load from a register, stalled for stall cycles, then
+    -- two cycles, retires in the last
+    procedure read_reg_stalled(reg : in integer; stall : in integer; value : out data_type) is
+    begin
+        csio <= '1';
+        wren <= '0';
+        address <= std_logic_vector(to_unsigned(reg*4, 32));
+        instret <= '0';
+        for i in 0 to stall loop
+            wait until falling_edge(clk);
+        end loop;
+        instret <= '1';
+        wait until falling_edge(clk);
+        value := dataout;
+        csio <= '0';
+        instret <= '0';
+    end procedure;
+
+    -- Load from a register, two cycles, retires in the second
+    procedure read_reg(reg : in integer; value : out data_type) is
+    begin
+        read_reg_stalled(reg, 0, value);
+    end procedure;
+
+    -- Load from a register that does not retire, two cycles
+    procedure read_reg_cancel(reg : in integer) is
+    begin
+        csio <= '1';
+        wren <= '0';
+        address <= std_logic_vector(to_unsigned(reg*4, 32));
+        instret <= '0';
+        wait until falling_edge(clk);
+        wait until falling_edge(clk);
+        csio <= '0';
+    end procedure;
+
+    -- Wait for a number of clock cycles
+    procedure wait_cycles(n : in integer) is
+    begin
+        for i in 1 to n loop
+            wait until falling_edge(clk);
+        end loop;
+    end procedure;
+
+    -- Wait until the receive FIFO holds level bytes
+    procedure wait_rxlevel(level : in integer) is
+    variable stat : data_type;
+    begin
+        for i in 0 to 100000 loop
+            read_reg(usartstat_addr, stat);
+            if to_integer(unsigned(stat(23 downto 16))) = level and stat(31 downto 24) = x"00" then
+                return;
+            end if;
+        end loop;
+        report "RX level " & integer'image(to_integer(unsigned(stat(23 downto 16)))) &
+               ", expected " & integer'image(level) severity error;
+    end procedure;
+
+    -- Check the received bytes, read back-to-back
+    procedure check_bytes(first : in integer; n : in integer) is
+    variable value : data_type;
+    begin
+        for i in 0 to n-1 loop
+            read_reg(usartdata_addr, value);
+            assert to_integer(unsigned(value)) = (first + i) mod 256
+                report "Read " & integer'image(to_integer(unsigned(value))) &
+                       ", expected " & integer'image((first + i) mod 256) severity error;
+        end loop;
+    end procedure;
+
+    -- Check the received bytes with loads that retire in
+    -- consecutive cycles, the first load takes two cycles
+    procedure check_bytes_fast(first : in integer; n : in integer) is
+    begin
+        csio <= '1';
+        wren <= '0';
+        address <= std_logic_vector(to_unsigned(usartdata_addr*4, 32));
+        instret <= '0';
+        wait until falling_edge(clk);
+        instret <= '1';
+        for i in 0 to n-1 loop
+            wait until falling_edge(clk);
+            assert to_integer(unsigned(dataout)) = (first + i) mod 256
+                report "Read " & integer'image(to_integer(unsigned(dataout))) &
+                       ", expected " & integer'image((first + i) mod 256) &
+                       " in consecutive cycles" severity error;
+        end loop;
+        csio <= '0';
+        instret <= '0';
+    end procedure;
+
+    begin
+        areset <= '1';
+        csio <= '0';
+        wren <= '0';
+        instret <= '0';
+        address <= (others => '0');
+        datain <= (others => '0');
+        wait for 15 ns;
+        areset <= '0';
+        wait until falling_edge(clk);
+
+        write_reg(usartbaud_addr, baud);
+        write_reg(usartctrl_addr, fen);
+
+        -- A few bytes, written and read back-to-back
+        for i in 0 to 4 loop
+            write_reg(usartdata_addr, std_logic_vector(to_unsigned(16#41# + i, 32)));
+        end loop;
+        wait_rxlevel(5);
+        read_reg(usartstat_addr, data);
+        assert data(2) = '1' and data(8) = '1' report "RC or RXT not set" severity error;
+        check_bytes(16#41#, 5);
+        read_reg(usartstat_addr, data);
+        assert data(2) = '0' and data(23 downto 16) = x"00" report "RX FIFO not empty" severity error;
+
+        -- Full FIFOs, repeated so that the pointers wrap around
+        count := 0;
+        for round in 0 to 4 loop
+            for i in 0 to usart_fifo_size-1 loop
+                write_reg(usartdata_addr, std_logic_vector(to_unsigned((count + i) mod 256, 32)));
+            end loop;
+            wait_rxlevel(usart_fifo_size);
+            check_bytes(count, usart_fifo_size);
+            count := count + usart_fifo_size;
+        end loop;
+        read_reg(usartstat_addr, data);
+        assert data(6) = '0' report "Unexpected RX overrun" severity error;
+
+        -- One byte more than the receive FIFO holds sets OR,
+        -- the extra byte is lost
+        for i in 0 to usart_fifo_size-1 loop
+            write_reg(usartdata_addr, std_logic_vector(to_unsigned(i, 32)));
+        end loop;
+        wait_rxlevel(usart_fifo_size);
+        write_reg(usartdata_addr, x"000000ff");
+        wait for 200 * 20 ns;
+        wait until falling_edge(clk);
+        read_reg(usartstat_addr, data);
+        assert data(6) = '1' report "RX overrun not set" severity error;
+        assert to_integer(unsigned(data(23 downto 16))) = usart_fifo_size
+            report "RX level changed on overrun" severity error;
+        check_bytes(0, usart_fifo_size);
+        write_reg(usartstat_addr, x"00000000");
+
+        -- TXT is a level: the interrupt stays asserted while the
+        -- transmit FIFO is at or below the threshold and TXTIE is set
+        write_reg(usartctrl_addr, x"02000500");
+        wait until falling_edge(clk);
+        assert intrio(18) = '1' report "TXT interrupt not asserted" severity error;
+        wait for 10 * 20 ns;
+        wait until falling_edge(clk);
+        assert intrio(18) = '1' report "TXT interrupt not held" severity error;
+        write_reg(usartctrl_addr, fen);
+        wait until falling_edge(clk);
+        assert intrio(18) = '0' report "TXT interrupt not negated" severity error;
+
+        -- Clearing FEN empties the FIFOs
+        write_reg(usartdata_addr, x"00000055");
+        wait_rxlevel(1);
+        write_reg(usartctrl_addr, x"00000000");
+        write_reg(usartctrl_addr, fen);
+        read_reg(usartstat_addr, data);
+        assert data(31 downto 16) = x"0000" report "FIFOs not emptied" severity error;
+
+        -- Loads that retire in consecutive cycles return
+        -- successive bytes
+        for i in 0 to 3 loop
+            write_reg(usartdata_addr, std_logic_vector(to_unsigned(16#71# + i, 32)));
+        end loop;
+        wait_rxlevel(4);
+        check_bytes_fast(16#71#, 4);
+        read_reg(usartstat_addr, data);
+        assert data(23 downto 16) = x"00" report "RX FIFO not empty after consecutive loads" severity error;
+
+        -- A stalled load removes one byte, a load that does not
+        -- retire removes none
+        for i in 0 to 2 loop
+            write_reg(usartdata_addr, std_logic_vector(to_unsigned(16#61# + i, 32)));
+        end loop;
+        wait_rxlevel(3);
+        read_reg_stalled(usartdata_addr, 5, data);
+        assert data = x"00000061" report "Stalled load read " &
+            integer'image(to_integer(unsigned(data))) & ", expected 97" severity error;
+        read_reg_cancel(usartdata_addr);
+        read_reg(usartstat_addr, data);
+        assert data(23 downto 16) = x"02" report "RX level changed by a stalled or cancelled load" severity error;
+        check_bytes(16#62#, 2);
+
+        -- A store that does not retire is not sent and leaves TC set
+        write_reg_cancel(usartdata_addr, x"00000077");
+        read_reg(usartstat_addr, data);
+        assert data(31 downto 24) = x"00" report "Cancelled store entered the TX FIFO" severity error;
+        assert data(4) = '1' report "TC cleared by a cancelled store" severity error;
+        wait_cycles(200);
+        read_reg(usartstat_addr, data);
+        assert data(23 downto 16) = x"00" report "Cancelled store was sent" severity error;
+
+        -- A load in the cycle in which a byte enters the empty
+        -- receive FIFO. Either the load returns the byte and
+        -- removes it, or the byte stays in the FIFO. The delay
+        -- is swept over the cycle in which the byte is received
+        hits := 0;
+        misses := 0;
+        for delay in 0 to 39 loop
+            write_reg(usartdata_addr, std_logic_vector(to_unsigned(16#a0# + delay, 32)));
+            wait_cycles(80 + delay);
+            read_reg(usartdata_addr, value);
+            wait_cycles(200);
+            read_reg(usartstat_addr, data);
+            if to_integer(unsigned(value)) = 16#a0# + delay then
+                hits := hits + 1;
+                assert data(23 downto 16) = x"00" report "Byte read but not removed, delay " &
+                    integer'image(delay) severity error;
+            else
+                misses := misses + 1;
+                assert data(23 downto 16) = x"01" report "Byte lost, delay " &
+                    integer'image(delay) severity error;
+                check_bytes(16#a0# + delay, 1);
+            end if;
+        end loop;
+        assert hits > 0 and misses > 0 report "Load did not meet the received byte" severity error;
+
+        -- A store that does not retire in the cycle in which the
+        -- last byte is sent does not hold off TC. The delay is
+        -- swept over the end of the transmission
+        for delay in 0 to 39 loop
+            write_reg(usartdata_addr, x"00000011");
+            wait_cycles(80 + delay);
+            write_reg_cancel(usartdata_addr, x"00000022");
+            wait_cycles(200);
+            read_reg(usartstat_addr, data);
+            assert data(4) = '1' report "TC not set, delay " & integer'image(delay) severity error;
+            assert data(31 downto 24) = x"00" report "TX FIFO not empty" severity error;
+            check_bytes(16#11#, 1);
+            read_reg(usartstat_addr, data);
+            assert data(23 downto 16) = x"00" report "Cancelled store was sent" severity error;
+        end loop;
+
+        report "USART FIFO test done" severity note;
+        finished <= true;
+        wait;
+    end process;
+
+end architecture sim;
@@ -104,6 +104,13 @@ package processor_common is
     constant rom_size : integer := 2**(rom_size_bits-2);
     type rom_type is array(0 to rom_size-1) of data_type;
     -- The contents of the ROM is loaded by processor_common_rom.vhd
+    -- If set, the contents is read from this data file instead,
+    -- made with srec2vhdl -t. The file is read at elaboration.
+    constant rom_init_file : string := "";
+    -- If set, Quartus initializes the ROM from this MIF file,
+    -- made with srec2mif -w -s <rom_size_bits>. The contents
+    -- can then be updated without synthesis, see update-mif.
+    constant rom_mif_file : string := "";
     
     -- The RAM
     -- NOTE: the RAM is 4x byte (8 bits) size, supporting
@@ -115,6 +122,10 @@ package processor_common is
     constant ram_size : integer := 2**(ram_size_bits-2);
     -- The type of the RAM block
     type ram_type is array (0 to ram_size-1) of std_logic_vector(7 downto 0);
+    -- If set, the RAM is preloaded from this data file, made
+    -- with srec2vhdl -t -w from the initialized data. The file
+    -- is read at elaboration.
+    constant ram_init_file : string := "";
                         
     -- The I/O
     -- NOTE: the I/O is word (32 bits) size, Big Endian
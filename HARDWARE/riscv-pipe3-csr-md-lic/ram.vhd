@@ -13,11 +13,14 @@
 
 -- This file contains the description of a RAM block. The
 -- RAM is placed in onboard RAM blocks. A write takes one
--- clock cycle, a read takes two clock cycles.
+-- clock cycle, a read takes two clock cycles. The RAM can be
+-- preloaded from the data file ram_init_file.
 
 library ieee;
 use ieee.std_logic_1164.all;
 use ieee.numeric_std.all;
+use ieee.std_logic_textio.all;
+use std.textio.all;
 
 library work;
 use work.processor_common.all;
@@ -39,7 +42,41 @@ end entity ram;
 
 architecture rtl of ram is
 
-signal ramhh, ramhl, ramlh, ramll : ram_type;
+-- Read one byte lane of the RAM contents from a data file made
+-- by srec2vhdl -t -w. Every line holds a word index and a hex
+-- value. Lane 3 (ramhh) is the byte at the lowest address.
+impure function read_ram_file(name : string; lane : integer) return ram_type is
+file ramfile : text open read_mode is name;
+variable l : line;
+variable index : integer;
+variable value : data_type;
+variable contents : ram_type := (others => (others => '0'));
+begin
+    while not endfile(ramfile) loop
+        readline(ramfile, l);
+        read(l, index);
+        hread(l, value);
+        if index < ram_size then
+            contents(index) := value(lane*8+7 downto lane*8);
+        end if;
+    end loop;
+    return contents;
+end function read_ram_file;
+
+-- Use the data file if there is one
+impure function init_ram(lane : integer) return ram_type is
+begin
+    if ram_init_file = "" then
+        return (others => (others => '0'));
+    else
+        return read_ram_file(ram_init_file, lane);
+    end if;
+end function init_ram;
+
+signal ramhh : ram_type := init_ram(3);
+signal ramhl : ram_type := init_ram(2);
+signal ramlh : ram_type := init_ram(1);
+signal ramll : ram_type := init_ram(0);
 -- synthesis translate_off
 -- Only for simulation, skip in synthesis
 type ram_alt_type is array (0 to ram_size-1) of data_type;
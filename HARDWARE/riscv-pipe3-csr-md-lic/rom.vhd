@@ -14,11 +14,14 @@
 -- This file contains the description of the ROM. The ROM
 -- is placed in immutable onboard RAM blocks. A read takes two
 -- clock cycles, for both instruction and data. The ROM
--- contents is placed in file processor_common_rom.vhd
+-- contents is placed in file processor_common_rom.vhd or is
+-- read from the data file rom_init_file.
 
 library ieee;
 use ieee.std_logic_1164.all;
 use ieee.numeric_std.all;
+use ieee.std_logic_textio.all;
+use std.textio.all;
 
 library work;
 use work.processor_common.all;
@@ -42,8 +45,41 @@ end entity rom;
 
 architecture rtl of rom is
 
+-- Read the ROM contents from a data file made by srec2vhdl -t.
+-- Every line holds an element index and a hex value.
+impure function read_rom_file(name : string) return rom_type is
+file romfile : text open read_mode is name;
+variable l : line;
+variable index : integer;
+variable value : data_type;
+variable contents : rom_type := (others => (others => '0'));
+begin
+    while not endfile(romfile) loop
+        readline(romfile, l);
+        read(l, index);
+        hread(l, value);
+        if index < rom_size then
+            contents(index) := value;
+        end if;
+    end loop;
+    return contents;
+end function read_rom_file;
+
+-- Use the data file if there is one
+impure function init_rom return rom_type is
+begin
+    if rom_init_file = "" then
+        return rom_contents;
+    else
+        return read_rom_file(rom_init_file);
+    end if;
+end function init_rom;
+
 -- The rom.
-signal rom : rom_type := rom_contents;
+signal rom : rom_type := init_rom;
+-- Quartus initializes the ROM from a MIF file, if set
+attribute ram_init_file : string;
+attribute ram_init_file of rom : signal is rom_mif_file;
 
 begin
 